@@ -0,0 +1,72 @@
+/**
+ * @file det_cfg.c
+ * @author Mohamed Hassanin
+ * @brief A default error tracer configuration file.
+ * @version 0.1
+ * @date 2021-03-12
+ */
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include "det_cfg.h"
+#include "uart.h"
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/**
+* The following array contains the handling of each UART error. Each row
+* represents an error and is indexed by the UartError_t value. The receive
+* errors are only traced so their reporting stays cheap on the hot path.
+*/
+static const DetErrorConfig_t DetUartErrors[UART_E_MAX] =
+{
+  { DET_SEVERITY_TRACE, 0x00 }, /* UART_E_PARAM */
+  { DET_SEVERITY_TRACE, 0x00 }, /* UART_E_FRAME */
+  { DET_SEVERITY_TRACE, 0x00 }, /* UART_E_OVERRUN */
+  { DET_SEVERITY_TRACE, 0x00 }, /* UART_E_PARITY */
+  { DET_SEVERITY_TRACE, 0x00 }, /* UART_E_TB_NEMPTY */
+  { DET_SEVERITY_TRACE, 0x00 }, /* UART_E_RX_OVERFLOW */
+  { DET_SEVERITY_TRACE, 0x00 }  /* UART_E_AUTOBAUD */
+};
+
+/**
+* The following array contains the handling of the errors of each module.
+* Each row represents a module and is indexed by the module id. This table is
+* read in by Det_Init, so a report is dispatched by a single table lookup.
+*/
+static const DetModuleConfig_t DetConfig[DET_MODULE_COUNT] =
+{
+  { 0x00, 0 },
+  { DetUartErrors, UART_E_MAX } /* UART_MODULE_ID */
+};
+
+/**
+ * brief compile time check that the UART module has a row in DetConfig
+ */
+typedef char DetUartModuleCheck_t[(UART_MODULE_ID < DET_MODULE_COUNT) ? 1 : -1];
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : Det_GetConfig()
+*//**
+* \b Description:
+* This function is used to get the cofiguration handle of the Det <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* module table will be returned. <br>
+* @return A pointer to the module table.
+*
+* \b Example Example:
+* @code
+* Det_Init(Det_GetConfig());
+* @endcode
+* @see Det_Init
+**********************************************************************/
+extern const DetModuleConfig_t *
+Det_GetConfig(void)
+{
+  return (const DetModuleConfig_t *) DetConfig;
+}
+/*****************************End of File ************************************/
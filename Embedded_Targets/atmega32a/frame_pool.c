@@ -0,0 +1,199 @@
+/**
+ * @file frame_pool.c
+ * @author Mohamed Hassanin
+ * @brief A pool of fixed-size frame buffers. The frames are referred to by
+ * handles and the free frames are kept in a ring of handles, so allocating
+ * and freeing a frame is O(1) and copies no data.
+ * @version 0.1
+ * @date 2021-02-15
+ * 
+ * @copyright Copyright (c) 2021
+ * 
+ */
+/*******************************************************************
+ * Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "frame_pool.h"
+/*********************************************************************
+ * Module Variable Definitions
+**********************************************************************/
+/**
+ * brief compile time check that every frame has a bit in the pool bitmaps
+ */
+typedef char FramePoolBitmapCheck_t[(FRAME_POOL_MAX_FRAMES <= 8) ? 1 : -1];
+
+/*********************************************************************
+ * Function Definitions
+**********************************************************************/
+/*********************************************************************
+* Function : FramePool_Create()
+*//**
+* \b Description:
+*
+* This function is used to create a frame pool from a piece of memory,
+* all its frames are free.
+*
+* @param Pool a pointer to the pool to create.
+* @param Data a piece of memory of Count * FrameSize bytes for the frames.
+* @param Length a piece of memory of Count bytes for the frame lengths.
+* @param FrameSize the size of a frame.
+* @param Count the number of frames, 1 to FRAME_POOL_MAX_FRAMES.
+* @return uint8_t 1 if the pool is created, 0 otherwise.
+*
+* \b Example:
+* @code
+* static uint8_t FrameData[4 * 32];
+* static uint8_t FrameLength[4];
+* static FramePool_t Pool;
+* FramePool_Create(&Pool, FrameData, FrameLength, 32, 4);
+* @endcode
+*
+* @see FramePool_Alloc
+**********************************************************************/
+extern uint8_t
+FramePool_Create(FramePool_t* Pool, uint8_t* Data, uint8_t* Length,
+  uint8_t FrameSize, uint8_t Count)
+{
+#if (FRAME_POOL_DEV_ERROR_DETECT == 1)
+  if(Pool == 0x00 || Data == 0x00 || Length == 0x00) return 0;
+#endif
+
+  if(Count == 0 || Count > FRAME_POOL_MAX_FRAMES || FrameSize == 0) return 0;
+
+  Pool->Data = Data;
+  Pool->Length = Length;
+  Pool->FrameSize = FrameSize;
+  Pool->Count = Count;
+  Pool->Allocs = 0;
+  Pool->Frees = 0;
+
+  FrameRing_Reset(&Pool->Free);
+  for(FrameHandle_t Frame = 0; Frame < Count; Frame++)
+    {
+      Pool->Length[Frame] = 0;
+      FrameRing_Enqueue(&Pool->Free, Frame);
+    }
+
+  return 1;
+}
+
+/*********************************************************************
+* Function : FramePool_Alloc()
+*//**
+* \b Description:
+*
+* This function is used to take a free frame from a pool, its length is
+* cleared.
+*
+* @param Pool a valid pointer to the pool
+* @return FrameHandle_t the handle of the frame, FRAME_NONE if no frame is
+* free
+*
+* \b Example:
+* @code
+* FrameHandle_t Frame = FramePool_Alloc(&Pool);
+* if(Frame != FRAME_NONE)
+*   {
+*     FramePool_Data(&Pool, Frame)[0] = 'a';
+*     FramePool_SetLength(&Pool, Frame, 1);
+*   }
+* @endcode
+*
+* @see FramePool_Free
+**********************************************************************/
+extern FrameHandle_t
+FramePool_Alloc(FramePool_t* Pool)
+{
+  FrameHandle_t Frame;
+
+#if (FRAME_POOL_DEV_ERROR_DETECT == 1)
+  if(Pool == 0x00) return FRAME_NONE;
+#endif
+
+  if(FrameRing_Dequeue(&Pool->Free, &Frame) == 0) return FRAME_NONE;
+
+  Pool->Length[Frame] = 0;
+  CIRCBUFF_STORE_RELEASE(Pool->Allocs, (uint8_t) (Pool->Allocs ^ (1 << Frame)));
+
+  return Frame;
+}
+
+/*********************************************************************
+* Function : FramePool_Free()
+*//**
+* \b Description:
+*
+* This function is used to give a frame back to its pool. A handle that
+* is not allocated (e.g. freed twice) is rejected, so it's never queued
+* twice in the free ring.
+*
+* @param Pool a valid pointer to the pool
+* @param Frame a handle allocated from the pool, it must not be used after
+* @return uint8_t 1 if the frame is freed, 0 if the handle is invalid or
+* not allocated
+*
+* @see FramePool_Alloc
+**********************************************************************/
+extern uint8_t
+FramePool_Free(FramePool_t* Pool, FrameHandle_t Frame)
+{
+#if (FRAME_POOL_DEV_ERROR_DETECT == 1)
+  if(Pool == 0x00) return 0;
+#endif
+
+  if(FramePool_IsAllocated(Pool, Frame) == 0) return 0;
+
+  //the frame is marked free before its handle is published
+  Pool->Frees ^= (uint8_t) (1 << Frame);
+
+  return FrameRing_Enqueue(&Pool->Free, Frame);
+}
+
+/*********************************************************************
+* Function : FramePool_GetFree()
+*//**
+* \b Description:
+*
+* This function is used to get the number of free frames of a pool.
+*
+* @param Pool a valid pointer to the pool
+* @return uint8_t the number of free frames, 0 if Pool is invalid
+**********************************************************************/
+extern uint8_t
+FramePool_GetFree(FramePool_t* Pool)
+{
+#if (FRAME_POOL_DEV_ERROR_DETECT == 1)
+  if(Pool == 0x00) return 0;
+#endif
+
+  return FrameRing_Count(&Pool->Free);
+}
+
+/*********************************************************************
+* Function : FramePool_IsAllocated()
+*//**
+* \b Description:
+*
+* This function is used to check if a frame of a pool is allocated. It's
+* called by the side that frees the frames.
+*
+* @param Pool a valid pointer to the pool
+* @param Frame a handle of a frame
+* @return uint8_t 1 if the frame is allocated, 0 if it's free or the handle
+* is invalid
+*
+* @see FramePool_Free
+**********************************************************************/
+extern uint8_t
+FramePool_IsAllocated(FramePool_t* Pool, FrameHandle_t Frame)
+{
+#if (FRAME_POOL_DEV_ERROR_DETECT == 1)
+  if(Pool == 0x00) return 0;
+#endif
+
+  if(!(Frame < Pool->Count)) return 0;
+
+  return ((CIRCBUFF_LOAD_ACQUIRE(Pool->Allocs) ^ Pool->Frees) >> Frame) & 0x01;
+}
+/************************End Of File ******************************/
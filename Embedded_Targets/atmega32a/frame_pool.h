@@ -0,0 +1,131 @@
+/**
+ * @file frame_pool.h
+ * @author Mohamed Hassanin
+ * @brief A pool of fixed-size frame buffers. The frames are referred to by
+ * handles and the free frames are kept in a ring of handles, so allocating
+ * and freeing a frame is O(1) and copies no data.
+ * @version 0.1
+ * @date 2021-02-15
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef FRAME_POOL_H
+#define FRAME_POOL_H
+
+/*******************************************************************
+ * Includes
+*******************************************************************/
+#include <inttypes.h>
+#include "circ_buffer_gen.h"
+/*******************************************************************
+ * Preprocessor constants
+*******************************************************************/
+#ifndef FRAME_POOL_DEV_ERROR_DETECT
+#define FRAME_POOL_DEV_ERROR_DETECT 1 /**< 1 to check the pointers passed to
+the pool functions, 0 to remove the checks in release builds */
+#endif
+
+#ifndef FRAME_POOL_MAX_FRAMES
+#define FRAME_POOL_MAX_FRAMES 8 /**< define the largest number of frames in a
+pool, it sizes the rings of handles, at most 8 */
+#endif
+
+#define FRAME_NONE 0xFF /**< an invalid frame handle */
+/*******************************************************************
+ * typedefs
+*******************************************************************/
+/**
+ * @brief A handle of a frame of a pool, its index in the pool
+ */
+typedef uint8_t FrameHandle_t;
+
+/**
+ * @brief A ring of frame handles, FrameRing_t and its functions
+ * (FrameRing_Enqueue, FrameRing_Dequeue, ...). It can hold all the frames
+ * of a pool, so a frame queue never overflows.
+ */
+CIRCBUFF_GENERATE(FrameRing, FrameHandle_t, FRAME_POOL_MAX_FRAMES + 1)
+
+/**
+ * @brief A frame pool structure to hold the information of it.
+ *
+ * The free ring is a single producer single consumer ring, so a pool is
+ * lock-free when its frames are allocated in one context and freed in one
+ * other context (e.g. allocated in the receive ISR and freed by a task).
+ * For the same reason the allocated frames are tracked by two bitmaps, each
+ * written by one side: a frame is allocated when its bits differ.
+ */
+typedef struct
+{
+  FrameRing_t Free; /*< the handles of the free frames */
+  uint8_t* Data; /*< the frames data, Count * FrameSize bytes */
+  uint8_t* Length; /*< the number of used bytes of every frame */
+  uint8_t FrameSize; /*< the size of a frame */
+  uint8_t Count; /*< the number of frames */
+  uint8_t Allocs; /*< a bit per frame toggled by FramePool_Alloc */
+  uint8_t Frees; /*< a bit per frame toggled by FramePool_Free */
+} FramePool_t;
+/*******************************************************************
+ * Prototypes
+*******************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern uint8_t FramePool_Create(FramePool_t* Pool, uint8_t* Data,
+  uint8_t* Length, uint8_t FrameSize, uint8_t Count);
+extern FrameHandle_t FramePool_Alloc(FramePool_t* Pool);
+extern uint8_t FramePool_Free(FramePool_t* Pool, FrameHandle_t Frame);
+extern uint8_t FramePool_GetFree(FramePool_t* Pool);
+extern uint8_t FramePool_IsAllocated(FramePool_t* Pool, FrameHandle_t Frame);
+
+/*******************************************************************
+ * Inline functions
+*******************************************************************/
+/**
+ * @brief Gets the data of a frame.
+ * 
+ * @param Pool a valid pointer to the pool
+ * @param Frame a valid handle of a frame of the pool
+ * @return uint8_t* a pointer to the FrameSize bytes of the frame
+ */
+static inline uint8_t*
+FramePool_Data(const FramePool_t* Pool, FrameHandle_t Frame)
+{
+  return &Pool->Data[(uint16_t) Frame * Pool->FrameSize];
+}
+
+/**
+ * @brief Gets the number of used bytes of a frame.
+ * 
+ * @param Pool a valid pointer to the pool
+ * @param Frame a valid handle of a frame of the pool
+ * @return uint8_t the number of used bytes
+ */
+static inline uint8_t
+FramePool_GetLength(const FramePool_t* Pool, FrameHandle_t Frame)
+{
+  return Pool->Length[Frame];
+}
+
+/**
+ * @brief Sets the number of used bytes of a frame.
+ * 
+ * @param Pool a valid pointer to the pool
+ * @param Frame a valid handle of a frame of the pool
+ * @param Length the number of used bytes, at most FrameSize
+ */
+static inline void
+FramePool_SetLength(FramePool_t* Pool, FrameHandle_t Frame, uint8_t Length)
+{
+  Pool->Length[Frame] = Length;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* end FRAME_POOL_H */
+/************************End Of File ******************************/
@@ -0,0 +1,145 @@
+/**
+ * @file frame_pool_check.c
+ * @author Mohamed Hassanin
+ * @brief A host check of the frame pool: allocating every frame, freeing
+ * them, rejecting a double free and an invalid handle, and the Allocs/Frees
+ * bitmaps that track the allocated frames:
+ * @code
+ * gcc -std=c99 -I.. -I../../common frame_pool_check.c ../frame_pool.c \
+ *   -o frame_pool_check && ./frame_pool_check
+ * @endcode
+ * @version 0.1
+ * @date 2021-02-15
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "frame_pool.h"
+/******************************************************************************
+ * Preprocessor constants
+ ******************************************************************************/
+#define CHECK_FRAMES 4 /**< the number of frames of the pool */
+#define CHECK_FRAME_SIZE 16 /**< the size of a frame */
+#define CHECK_ALL ((1 << CHECK_FRAMES) - 1) /**< the bitmap of all the frames */
+/******************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+static uint8_t CheckData[CHECK_FRAMES * CHECK_FRAME_SIZE]; /**< the frames */
+static uint8_t CheckLength[CHECK_FRAMES]; /**< the frame lengths */
+static FramePool_t CheckPool; /**< the pool */
+static unsigned CheckFailed; /**< the number of failed checks */
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Check()
+*//**
+* \b Description:
+* Utility function is used to print the result of a check.
+*
+* @param Name the check name
+* @param Passed 1 if the check passed
+* @return void
+*******************************************************************************/
+static void
+Check(const char* Name, int Passed)
+{
+  printf("%-48s %s\n", Name, Passed ? "ok" : "FAILED");
+  if(!Passed) CheckFailed++;
+}
+
+/******************************************************************************
+* Function : Check_Allocated()
+*//**
+* \b Description:
+* Utility function is used to get the allocated frames of the pool as a
+* bitmap, through FramePool_IsAllocated.
+*
+* @return uint8_t a bit per allocated frame
+*******************************************************************************/
+static uint8_t
+Check_Allocated(void)
+{
+  uint8_t Map = 0;
+
+  for(FrameHandle_t Frame = 0; Frame < CHECK_FRAMES; Frame++)
+    {
+      Map |= (uint8_t) (FramePool_IsAllocated(&CheckPool, Frame) << Frame);
+    }
+
+  return Map;
+}
+
+int
+main(void)
+{
+  FrameHandle_t Frames[CHECK_FRAMES];
+  uint8_t Distinct = 1;
+
+  Check("no frames is rejected",
+    FramePool_Create(&CheckPool, CheckData, CheckLength, CHECK_FRAME_SIZE, 0) == 0);
+  Check("more than FRAME_POOL_MAX_FRAMES is rejected",
+    FramePool_Create(&CheckPool, CheckData, CheckLength, CHECK_FRAME_SIZE,
+      FRAME_POOL_MAX_FRAMES + 1) == 0);
+#if (FRAME_POOL_DEV_ERROR_DETECT == 1)
+  Check("a null pool is rejected",
+    FramePool_Create(0x00, CheckData, CheckLength, CHECK_FRAME_SIZE, CHECK_FRAMES) == 0 &&
+    FramePool_Alloc(0x00) == FRAME_NONE && FramePool_Free(0x00, 0) == 0);
+#endif
+
+  Check("the pool is created",
+    FramePool_Create(&CheckPool, CheckData, CheckLength, CHECK_FRAME_SIZE,
+      CHECK_FRAMES) == 1);
+  Check("every frame is free", FramePool_GetFree(&CheckPool) == CHECK_FRAMES &&
+    Check_Allocated() == 0);
+
+  //allocate every frame, each one has its own data
+  for(uint8_t i = 0; i < CHECK_FRAMES; i++)
+    {
+      Frames[i] = FramePool_Alloc(&CheckPool);
+      for(uint8_t j = 0; j < i; j++)
+        {
+          if(Frames[i] == Frames[j] || Frames[i] >= CHECK_FRAMES) Distinct = 0;
+        }
+      FramePool_Data(&CheckPool, Frames[i])[CHECK_FRAME_SIZE - 1] = i;
+      FramePool_SetLength(&CheckPool, Frames[i], i);
+    }
+
+  Check("every frame is allocated once", Distinct == 1 &&
+    FramePool_GetFree(&CheckPool) == 0 && Check_Allocated() == CHECK_ALL);
+  Check("the frames don't overlap",
+    FramePool_Data(&CheckPool, Frames[0])[CHECK_FRAME_SIZE - 1] == 0 &&
+    FramePool_Data(&CheckPool, Frames[CHECK_FRAMES - 1])[CHECK_FRAME_SIZE - 1] ==
+      CHECK_FRAMES - 1);
+  Check("an empty pool allocates nothing", FramePool_Alloc(&CheckPool) == FRAME_NONE);
+  Check("the bitmaps differ for the allocated frames",
+    (uint8_t) (CheckPool.Allocs ^ CheckPool.Frees) == CHECK_ALL);
+
+  //free, double free and an invalid handle
+  Check("a frame is freed", FramePool_Free(&CheckPool, Frames[1]) == 1 &&
+    FramePool_IsAllocated(&CheckPool, Frames[1]) == 0);
+  Check("a double free is rejected", FramePool_Free(&CheckPool, Frames[1]) == 0 &&
+    FramePool_GetFree(&CheckPool) == 1);
+  Check("an invalid handle is rejected", FramePool_Free(&CheckPool, CHECK_FRAMES) == 0 &&
+    FramePool_Free(&CheckPool, FRAME_NONE) == 0 &&
+    FramePool_IsAllocated(&CheckPool, FRAME_NONE) == 0);
+
+  //a freed frame is allocated again with its length cleared
+  Check("the freed frame is allocated again",
+    FramePool_Alloc(&CheckPool) == Frames[1] &&
+    FramePool_GetLength(&CheckPool, Frames[1]) == 0 && Check_Allocated() == CHECK_ALL);
+
+  //the bits of a frame are toggled by every allocation and free, a frame is
+  //allocated while they differ
+  for(uint8_t i = 0; i < CHECK_FRAMES; i++) FramePool_Free(&CheckPool, Frames[i]);
+  Check("every frame is freed", FramePool_GetFree(&CheckPool) == CHECK_FRAMES &&
+    Check_Allocated() == 0 && CheckPool.Allocs == CheckPool.Frees);
+  Check("the bits of the reused frame toggled twice",
+    ((CheckPool.Allocs >> Frames[1]) & 0x01) == 0 &&
+    ((CheckPool.Allocs >> Frames[0]) & 0x01) == 1);
+
+  printf("%u failed\n", CheckFailed);
+  return CheckFailed == 0 ? 0 : 1;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,100 @@
+/**
+ * @file uart_autobaud_check.c
+ * @author Mohamed Hassanin
+ * @brief A host check of the baudrate measurement: the capture only stores
+ * the measured baudrate, Uart_ServiceAll applies it and reports a baudrate
+ * out of range with nothing received:
+ * @code
+ * gcc -std=c99 -I. -I.. -I../../common -DUART_HOST_REGS=1 uart_autobaud_check.c \
+ *   ../uart.c ../uart_trace.c ../frame_pool.c ../det_cfg.c \
+ *   ../../common/circ_buffer.c ../../common/det.c -o autobaud_check && ./autobaud_check
+ * @endcode
+ * @version 0.1
+ * @date 2021-03-08
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "uart_host_check.h"
+#include "det.h"
+#include "det_cfg.h"
+/******************************************************************************
+ * Preprocessor constants
+ ******************************************************************************/
+#define CHECK_CLOCKS 625 /**< the system clocks per bit of the peer, 19200 at
+12 MHz */
+#define CHECK_UBRR ((CHECK_CLOCKS / 16) - 1) /**< the UBRR of the peer */
+/******************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+static const UartConfig_t CheckConfig =
+{
+  UART_0, 9600, UART_STOP_BIT_1, UART_PARTIY_NO, UART_DATA_BITS_8,
+  UART_FLOW_CONTROL_NONE, 0x00, 0x00, CIRCBUFF_DROP_NEW,
+  UART_RX_ERROR_DISCARD, UART_MPCM_OFF, 0x00, 0x00, UART_RX_MODE_RING,
+  UART_FRAME_END_NONE, 0
+};
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Check_Sync()
+*//**
+* \b Description:
+* Utility function is used to capture the edges of the sync character 0x55,
+* one edge per bit.
+*
+* @param Clocks the system clocks per bit
+* @return uint8_t the result of the last capture
+*******************************************************************************/
+static uint8_t
+Check_Sync(const uint16_t Clocks)
+{
+  uint8_t Locked = 0;
+
+  for(uint16_t Edge = 0; Edge < 10; Edge++)
+    {
+      Locked = Uart_AutobaudCapture(UART_0, (uint16_t) (100 + Edge * Clocks));
+    }
+
+  return Locked;
+}
+
+int
+main(void)
+{
+  DetTrace_t Trace;
+  uint8_t Data;
+
+  Det_Init(Det_GetConfig());
+  Uart_Init(&CheckConfig);
+
+  //one clock per bit is out of range
+  Uart_AutobaudStart(UART_0, 0x55);
+  Host_Check("a baudrate out of range isn't locked", Check_Sync(1) == 0);
+  Host_Check("the capture doesn't report it", Det_TraceRead(&Trace) == 0);
+  Uart_ServiceAll();
+  Host_Check("the service reports it with nothing received",
+    Det_TraceRead(&Trace) == 1 && Trace.ApiId == UART_AUTOBAUD_CAPTURE_ID &&
+    Trace.ErrorId == UART_E_AUTOBAUD);
+
+  //the next sync character is measured
+  Host_Check("the baudrate is locked", Check_Sync(CHECK_CLOCKS) == 1);
+  Host_Check("the capture doesn't write UBRR", *UBRRL != CHECK_UBRR);
+
+  //a frame received meanwhile is at the old baudrate
+  *UDR = 'x';
+  *UCSRA |= 1 << RXC;
+  Uart_ServiceAll();
+  *UCSRA &= (uint8_t) ~(1 << RXC);
+  Host_Check("the service applies it", *UBRRL == CHECK_UBRR && *UBRRH == 0);
+  Host_Check("the frame received before is discarded", Uart_ReceiveByte(UART_0, &Data) == 0);
+
+  Host_Receive('y', 0);
+  Host_Check("the next frame is received",
+    Uart_ReceiveByte(UART_0, &Data) == 1 && Data == 'y');
+  Host_Check("no error reported", Det_TraceRead(&Trace) == 0);
+
+  return Host_Result();
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,115 @@
+/**
+ * @file uart_host_check.h
+ * @author Mohamed Hassanin
+ * @brief The harness of the host checks of the ATmega32A driver. The
+ * registers are mapped into RAM (UART_HOST_REGS) and the checks play the
+ * peer: they write the received frames and read the sent ones. RAM doesn't
+ * behave like the peripheral, so the checks set UDRE and TXC before every
+ * send update.
+ * @version 0.1
+ * @date 2021-03-08
+ */
+#ifndef UART_HOST_CHECK_H
+#define UART_HOST_CHECK_H
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "uart.h"
+#include "uart_memmap.h"
+/******************************************************************************
+ * Preprocessor constants
+ ******************************************************************************/
+#define HOST_NOTHING_SENT 0xFFFF /**< returned by Host_SendTick when the
+driver sent nothing */
+/******************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+volatile uint8_t UartHostRegs[0x60]; /**< the registers in RAM */
+static unsigned HostFailed; /**< the number of failed checks */
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Host_Check()
+*//**
+* \b Description:
+* Utility function is used to print the result of a check.
+*
+* @param Name the check name
+* @param Passed 1 if the check passed
+* @return void
+*******************************************************************************/
+static inline void
+Host_Check(const char* Name, int Passed)
+{
+  printf("%-48s %s\n", Name, Passed ? "ok" : "FAILED");
+  if(!Passed) HostFailed++;
+}
+
+/******************************************************************************
+* Function : Host_Receive()
+*//**
+* \b Description:
+* Utility function is used to receive a frame on UART_0 and to run a receive
+* update.
+*
+* @param Data the frame data
+* @param Bit8 the 9th bit of the frame, 1 for an address frame
+* @return void
+*******************************************************************************/
+static inline void
+Host_Receive(const uint8_t Data, const uint8_t Bit8)
+{
+  *UDR = Data;
+  if(Bit8) *UCSRB |= 1 << RXB8;
+  else *UCSRB &= (uint8_t) ~(1 << RXB8);
+  *UCSRA |= 1 << RXC;
+
+  Uart_ReceiveUpdate(UART_0);
+
+  *UCSRA &= (uint8_t) ~(1 << RXC);
+}
+
+/******************************************************************************
+* Function : Host_SendTick()
+*//**
+* \b Description:
+* Utility function is used to run a send update of UART_0 with an empty
+* transmit register and to get the frame it sent.
+*
+* @param Bit8 a pointer to store the 9th bit of the sent frame in, or 0x00
+* @return uint16_t the sent byte, HOST_NOTHING_SENT if none
+*******************************************************************************/
+static inline uint16_t
+Host_SendTick(uint8_t * const Bit8)
+{
+  *UCSRA |= 1 << UDRE | 1 << TXC;
+
+  Uart_SendUpdate(UART_0);
+
+  //Uart_Transmit clears UDRE with its write of the status register
+  if(*UCSRA & (1 << UDRE)) return HOST_NOTHING_SENT;
+
+  if(Bit8 != 0x00) *Bit8 = (*UCSRB >> TXB8) & 0x01;
+  return *UDR;
+}
+
+/******************************************************************************
+* Function : Host_Result()
+*//**
+* \b Description:
+* Utility function is used to print the number of failed checks.
+*
+* @return int the exit code, 0 if every check passed
+*******************************************************************************/
+static inline int
+Host_Result(void)
+{
+  printf("%u failed\n", HostFailed);
+  return HostFailed == 0 ? 0 : 1;
+}
+
+#endif /* UART_HOST_CHECK_H */
+/*****************************End of File ************************************/
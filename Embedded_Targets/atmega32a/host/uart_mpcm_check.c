@@ -0,0 +1,82 @@
+/**
+ * @file uart_mpcm_check.c
+ * @author Mohamed Hassanin
+ * @brief A host check of XON/XOFF flow control on an addressed bus (MPCM):
+ * the flow control characters are data frames, also right after an address
+ * frame, and an address frame with the value of XOFF doesn't stop sending:
+ * @code
+ * gcc -std=c99 -I. -I.. -I../../common -DUART_HOST_REGS=1 uart_mpcm_check.c \
+ *   ../uart.c ../uart_trace.c ../frame_pool.c ../det_cfg.c \
+ *   ../../common/circ_buffer.c ../../common/det.c -o mpcm_check && ./mpcm_check
+ * @endcode
+ * @version 0.1
+ * @date 2021-03-08
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "uart_host_check.h"
+/******************************************************************************
+ * Preprocessor constants
+ ******************************************************************************/
+#define CHECK_NODE 0x05 /**< the address of the node */
+#define CHECK_PEER 0x07 /**< the address of the peer */
+/******************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+static const UartConfig_t CheckConfig =
+{
+  UART_0, 9600, UART_STOP_BIT_1, UART_PARTIY_NO, UART_DATA_BITS_8,
+  UART_FLOW_CONTROL_XON_XOFF, 0x00, 0x00, CIRCBUFF_DROP_NEW,
+  UART_RX_ERROR_DISCARD, UART_MPCM_ON, CHECK_NODE, 0x00, UART_RX_MODE_RING,
+  UART_FRAME_END_NONE, 0
+};
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+int
+main(void)
+{
+  uint8_t Data[UART_BUFF_SIZE];
+  uint8_t Bit8 = 0;
+  uint16_t Sent;
+
+  Uart_Init(&CheckConfig);
+
+  //an address frame, then the receive buffer reaches the high watermark
+  Uart_SendAddress(UART_0, CHECK_PEER);
+  Sent = Host_SendTick(&Bit8);
+  Host_Check("the address is an address frame", Sent == CHECK_PEER && Bit8 == 1);
+
+  Host_Receive(CHECK_NODE, 1);
+  for(uint8_t i = 0; i < UART_RX_HIGH_WATERMARK; i++) Host_Receive('r', 0);
+
+  Sent = Host_SendTick(&Bit8);
+  Host_Check("XOFF after an address is a data frame", Sent == UART_XOFF && Bit8 == 0);
+
+  //an address with the value of XOFF is not a flow control character
+  Host_Receive(UART_XOFF, 1);
+  Host_Receive(CHECK_NODE, 1);
+  Uart_SendByte(UART_0, 'd');
+  Sent = Host_SendTick(&Bit8);
+  Host_Check("an address frame of XOFF doesn't stop sending", Sent == 'd' && Bit8 == 0);
+
+  //a data frame of XOFF does
+  Host_Receive(UART_XOFF, 0);
+  Uart_SendByte(UART_0, 'e');
+  Host_Check("a data frame of XOFF stops sending", Host_SendTick(0x00) == HOST_NOTHING_SENT);
+  Host_Receive(UART_XON, 0);
+  Host_Check("a data frame of XON resumes it", Host_SendTick(0x00) == 'e');
+
+  //an address frame, then the receive buffer drains below the low watermark
+  Uart_SendAddress(UART_0, CHECK_PEER);
+  Sent = Host_SendTick(&Bit8);
+  Host_Check("the second address is an address frame", Sent == CHECK_PEER && Bit8 == 1);
+
+  Uart_ReceiveString(UART_0, Data, UART_RX_HIGH_WATERMARK - UART_RX_LOW_WATERMARK);
+  Sent = Host_SendTick(&Bit8);
+  Host_Check("XON after an address is a data frame", Sent == UART_XON && Bit8 == 0);
+
+  return Host_Result();
+}
+/*****************************End of File ************************************/
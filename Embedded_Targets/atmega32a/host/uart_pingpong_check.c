@@ -0,0 +1,144 @@
+/**
+ * @file uart_pingpong_check.c
+ * @author Mohamed Hassanin
+ * @brief A host check of the double-buffered (ping-pong) reception: the
+ * buffers swap when full or after the idle ticks, a held burst isn't
+ * overwritten, and the peer is stopped at UART_PINGPONG_HIGH_WATERMARK while
+ * a burst is held and resumed when it's released:
+ * @code
+ * gcc -std=c99 -I. -I.. -I../../common -DUART_HOST_REGS=1 -DUART_PINGPONG_MODE=1 \
+ *   uart_pingpong_check.c ../uart.c ../uart_trace.c ../frame_pool.c ../det_cfg.c \
+ *   ../../common/circ_buffer.c ../../common/det.c -o pingpong_check && ./pingpong_check
+ * @endcode
+ * @version 0.1
+ * @date 2021-03-08
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "uart_host_check.h"
+/******************************************************************************
+ * Preprocessor constants
+ ******************************************************************************/
+#define CHECK_IDLE_TICKS 2 /**< the idle receive updates that end a burst */
+/******************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+static const UartConfig_t CheckConfig =
+{
+  UART_0, 9600, UART_STOP_BIT_1, UART_PARTIY_NO, UART_DATA_BITS_8,
+  UART_FLOW_CONTROL_NONE, 0x00, 0x00, CIRCBUFF_DROP_NEW,
+  UART_RX_ERROR_DISCARD, UART_MPCM_OFF, 0x00, 0x00, UART_RX_MODE_PINGPONG,
+  UART_FRAME_END_NONE, CHECK_IDLE_TICKS
+};
+
+static const UartConfig_t CheckFlowConfig =
+{
+  UART_0, 9600, UART_STOP_BIT_1, UART_PARTIY_NO, UART_DATA_BITS_8,
+  UART_FLOW_CONTROL_XON_XOFF, 0x00, 0x00, CIRCBUFF_DROP_NEW,
+  UART_RX_ERROR_DISCARD, UART_MPCM_OFF, 0x00, 0x00, UART_RX_MODE_PINGPONG,
+  UART_FRAME_END_NONE, 0
+};
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Check_Swap()
+*//**
+* \b Description:
+* Utility function is used to check the swap of a full buffer, the idle
+* ticks and the loss of the bytes received while both buffers are full.
+*
+* @return void
+*******************************************************************************/
+static void
+Check_Swap(void)
+{
+  const uint8_t* Burst;
+  uint8_t Length;
+
+  Uart_Init(&CheckConfig);
+
+  for(uint8_t i = 0; i < UART_PINGPONG_SIZE + 6; i++) Host_Receive(i, 0);
+
+  Length = Uart_ReceiveBurst(UART_0, &Burst);
+  Host_Check("a full buffer is a burst", Length == UART_PINGPONG_SIZE &&
+    Burst[0] == 0 && Burst[Length - 1] == UART_PINGPONG_SIZE - 1);
+  Host_Check("the burst is returned until released",
+    Uart_ReceiveBurst(UART_0, &Burst) == UART_PINGPONG_SIZE);
+
+  //the bytes after it wait in the other buffer while the burst is held
+  for(uint8_t i = 0; i < CHECK_IDLE_TICKS + 1; i++) Uart_ServiceAll();
+  Host_Check("the held burst isn't replaced", Uart_ReceiveBurst(UART_0, &Burst) ==
+    UART_PINGPONG_SIZE && Burst[0] == 0);
+
+  Host_Check("the burst is released", Uart_ReleaseBurst(UART_0) == 1);
+  Host_Check("a partial buffer waits for the idle ticks",
+    Uart_ReceiveBurst(UART_0, &Burst) == 0);
+  for(uint8_t i = 0; i < CHECK_IDLE_TICKS; i++) Uart_ServiceAll();
+
+  Length = Uart_ReceiveBurst(UART_0, &Burst);
+  Host_Check("the idle ticks end a burst", Length == 6 &&
+    Burst[0] == UART_PINGPONG_SIZE);
+
+  //both buffers full, the next bytes are lost
+  for(uint8_t i = 0; i < UART_PINGPONG_SIZE + 10; i++) Host_Receive(i, 0);
+  Host_Check("the bytes after both buffers are lost",
+    Uart_GetReceiveLost(UART_0) == 10);
+
+  Uart_ReleaseBurst(UART_0);
+  Host_Check("a full buffer waits for a byte to swap",
+    Uart_ReceiveBurst(UART_0, &Burst) == 0);
+  Host_Receive('z', 0);
+  Length = Uart_ReceiveBurst(UART_0, &Burst);
+  Host_Check("then it's the next burst", Length == UART_PINGPONG_SIZE &&
+    Burst[0] == 0);
+}
+
+/******************************************************************************
+* Function : Check_Watermark()
+*//**
+* \b Description:
+* Utility function is used to check the XON/XOFF flow control of the
+* double-buffered reception.
+*
+* @return void
+*******************************************************************************/
+static void
+Check_Watermark(void)
+{
+  const uint8_t* Burst;
+  uint16_t Sent = HOST_NOTHING_SENT;
+  uint8_t Received = 0;
+
+  Uart_Init(&CheckFlowConfig);
+
+  //the first buffer is held, the second one fills up to the watermark
+  while(Received < UART_PINGPONG_SIZE + UART_PINGPONG_HIGH_WATERMARK &&
+        Sent == HOST_NOTHING_SENT)
+    {
+      Host_Receive('a', 0);
+      Received++;
+      Sent = Host_SendTick(0x00);
+    }
+
+  Host_Check("the peer is stopped at the watermark", Sent == UART_XOFF &&
+    Received == UART_PINGPONG_SIZE + UART_PINGPONG_HIGH_WATERMARK);
+
+  Host_Check("the held burst is full",
+    Uart_ReceiveBurst(UART_0, &Burst) == UART_PINGPONG_SIZE);
+  Host_Check("nothing is sent while it's held", Host_SendTick(0x00) == HOST_NOTHING_SENT);
+
+  Uart_ReleaseBurst(UART_0);
+  Host_Check("the peer is resumed on release", Host_SendTick(0x00) == UART_XON);
+}
+
+int
+main(void)
+{
+  Check_Swap();
+  Check_Watermark();
+
+  return Host_Result();
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,198 @@
+/**
+ * @file ring_buffer.hpp
+ * @author Mohamed Hassanin
+ * @brief A header-only C++ circular buffer/queue of any element type. It's
+ * the template counterpart of CIRCBUFF_GENERATE (circ_buffer_gen.h) and
+ * shares the index logic of circ_buffer.h, the indexes wrap with a mask
+ * when the number of slots is a power of two.
+ * Note: one space is wasted in the buffer to know if it's empty
+ * @version 0.1
+ * @date 2021-02-15
+ */
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+#include "circ_buffer.h"
+
+namespace uart
+{
+/**
+ * @brief A circular buffer of N - 1 elements of type T. One producer and one
+ * consumer may use it concurrently without locking, each side writes its own
+ * index only and publishes it after the data. EnqueueOverwrite and Reset
+ * move both indexes so they are not safe with a concurrent other side.
+ *
+ * \b Example:
+ * @code
+ * static uart::RingBuffer<Frame_t*, 8> RxFrames;
+ *
+ * RxFrames.Enqueue(Frame); // in the ISR
+ * if(RxFrames.Dequeue(Frame)) Process(Frame); // in a task
+ * @endcode
+ *
+ * @tparam T the element type
+ * @tparam N the number of slots, 2 to 255
+ */
+template <typename T, uint8_t N>
+class RingBuffer
+{
+  static_assert(N >= 2, "a RingBuffer needs at least 2 slots");
+
+public:
+  static const uint8_t Capacity = N - 1; /**< the number of storable elements */
+
+  constexpr RingBuffer() : Buff(), Rear(0), Front(0) {}
+
+  /**
+   * @brief Adds an element to the queue (producer)
+   * @return true if it's stored, false if the queue is full
+   */
+  bool Enqueue(const T& Data)
+  {
+    uint8_t Next = NextSlot(Front);
+
+    if(Next == CIRCBUFF_LOAD_ACQUIRE(Rear)) return false;
+
+    Buff[Front] = Data;
+    CIRCBUFF_STORE_RELEASE(Front, Next);
+
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest element from the queue (consumer)
+   * @return true if an element is removed, false if the queue is empty
+   */
+  bool Dequeue(T& Data)
+  {
+    if(Rear == CIRCBUFF_LOAD_ACQUIRE(Front)) return false;
+
+    Data = Buff[Rear];
+    CIRCBUFF_STORE_RELEASE(Rear, NextSlot(Rear));
+
+    return true;
+  }
+
+  /**
+   * @brief Adds up to Count elements to the queue (producer), they are
+   * published at once
+   * @return the number of stored elements
+   */
+  uint8_t EnqueueBulk(const T * const Data, uint8_t Count)
+  {
+    uint8_t Next = Front;
+    uint8_t Free = (uint8_t) (Capacity -
+      SlotDistance(CIRCBUFF_LOAD_ACQUIRE(Rear), Next));
+
+    if(Count > Free) Count = Free;
+
+    for(uint8_t i = 0; i < Count; i++)
+      {
+        Buff[Next] = Data[i];
+        Next = NextSlot(Next);
+      }
+
+    CIRCBUFF_STORE_RELEASE(Front, Next);
+
+    return Count;
+  }
+
+  /**
+   * @brief Removes up to Count elements from the queue (consumer), they are
+   * released at once
+   * @return the number of removed elements
+   */
+  uint8_t DequeueBulk(T * const Data, uint8_t Count)
+  {
+    uint8_t Next = Rear;
+    uint8_t Used = SlotDistance(Next, CIRCBUFF_LOAD_ACQUIRE(Front));
+
+    if(Count > Used) Count = Used;
+
+    for(uint8_t i = 0; i < Count; i++)
+      {
+        Data[i] = Buff[Next];
+        Next = NextSlot(Next);
+      }
+
+    CIRCBUFF_STORE_RELEASE(Rear, Next);
+
+    return Count;
+  }
+
+  /**
+   * @brief Adds an element to the queue, overwriting the oldest one if full
+   * @return true if an element was overwritten
+   */
+  bool EnqueueOverwrite(const T& Data)
+  {
+    uint8_t Next = NextSlot(Front);
+    bool Overwritten = (Next == Rear);
+
+    if(Overwritten) Rear = NextSlot(Next);
+
+    Buff[Front] = Data;
+    CIRCBUFF_STORE_RELEASE(Front, Next);
+
+    return Overwritten;
+  }
+
+  /**
+   * @brief Gets the number of elements in the queue
+   */
+  uint8_t Count() const
+  {
+    return SlotDistance(CIRCBUFF_LOAD_ACQUIRE(Rear),
+      CIRCBUFF_LOAD_ACQUIRE(Front));
+  }
+
+  bool IsEmpty() const { return Count() == 0; }
+  bool IsFull() const { return Count() == Capacity; }
+  void Reset() { Rear = 0; Front = 0; }
+
+  /**
+   * @brief Gets the slot the next element is stored in (producer), e.g. to
+   * keep side information per slot
+   */
+  uint8_t FrontSlot() const { return Front; }
+
+  /**
+   * @brief Gets the slot of the oldest element (consumer)
+   */
+  uint8_t RearSlot() const { return Rear; }
+
+private:
+  static const bool PowerOfTwo = (N & (N - 1)) == 0; /**< the indexes wrap
+  with a mask */
+
+  /**
+   * @brief The slot after Index, a mask when N is a power of two and a
+   * compare against N otherwise (CircBuff_Next)
+   */
+  static uint8_t NextSlot(uint8_t Index)
+  {
+    return PowerOfTwo ? (uint8_t) ((Index + 1) & (N - 1)) : CircBuff_Next(Index, N);
+  }
+
+  /**
+   * @brief The number of slots from From to To, a mask when N is a power of
+   * two (CircBuff_Distance)
+   */
+  static uint8_t SlotDistance(uint8_t From, uint8_t To)
+  {
+    return PowerOfTwo ? (uint8_t) ((To - From) & (N - 1)) : CircBuff_Distance(From, To, N);
+  }
+
+  T Buff[N]; /**< the queue data */
+  uint8_t Rear; /**< the Rear of the queue, written by the consumer */
+  uint8_t Front; /**< the Front of the queue, written by the producer */
+};
+
+} // namespace uart
+
+#endif /* RING_BUFFER_HPP */
+/*****************************End of File ************************************/
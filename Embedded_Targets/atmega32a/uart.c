@@ -5,10 +5,6 @@
  * @version 0.1
  * @date 2021-03-08
  */
-/**********************************************************************
-* Preprocessor constants
-**********************************************************************/
-#define SYSTEM_FREQ (12000000ul) /**< system frequency */
 /******************************************************************************
  * Includes
  ******************************************************************************/
@@ -16,6 +12,135 @@
 #include "circ_buffer.h"
 #include "uart_memmap.h"
 #include "det.h"
+#include "uart_trace.h"
+/**********************************************************************
+* Preprocessor macros
+**********************************************************************/
+#if UART_CHANNEL_COUNT == 1
+/**
+ * In single channel builds the channel index is a constant, so the channel
+ * control block resolves to a fixed address and the registers are accessed
+ * directly instead of through the control block.
+ */
+#define UART_CHANNEL(Uart) ((void) (Uart), UART_0)
+#define UART_STATUS_REG(Channel) (*UCSRA)
+#define UART_CONTROL_REG(Channel) (*UCSRB)
+#define UART_DATA_REG(Channel) (*UDR)
+#else
+#define UART_CHANNEL(Uart) (Uart)
+#define UART_STATUS_REG(Channel) (*(Channel)->StatusReg)
+#define UART_CONTROL_REG(Channel) (*(Channel)->ControlReg)
+#define UART_DATA_REG(Channel) (*(Channel)->DataReg)
+#endif
+
+#define UART_SEND_DATA(Uart) UartSendData[UART_CHANNEL(Uart)]
+#define UART_RECEIVE_DATA(Uart) UartReceiveData[UART_CHANNEL(Uart)]
+
+#if (UART_CIRCBUFF_INLINE == 1)
+#define UART_ENQUEUE(Buff, BuffData, Data) \
+  CircBuff_EnqueueSized((Buff), (BuffData), UART_BUFF_SIZE, (Data))
+#define UART_DEQUEUE(Buff, BuffData, Data) \
+  CircBuff_DequeueSized((Buff), (BuffData), UART_BUFF_SIZE, (Data))
+#else
+#define UART_ENQUEUE(Buff, BuffData, Data) Uart_Enqueue((Buff), (BuffData), (Data))
+#define UART_DEQUEUE(Buff, BuffData, Data) Uart_Dequeue((Buff), (BuffData), (Data))
+#endif
+#define UART_COUNT(Buff) CircBuff_CountSized((Buff), UART_BUFF_SIZE)
+
+#define UART_FLAG_TX_STOPPED (1 << 0) /**< the peer sent XOFF */
+#define UART_FLAG_RX_STOPPED (1 << 1) /**< the peer was asked to stop */
+#define UART_FLAG_SEND_XOFF (1 << 2) /**< XOFF is waiting to be sent */
+#define UART_FLAG_SEND_XON (1 << 3) /**< XON is waiting to be sent */
+#define UART_FLAG_SEND_ADDRESS (1 << 4) /**< an address is waiting to be sent */
+#define UART_FLAG_DE_ASSERTED (1 << 5) /**< the transceiver is driving the bus */
+#define UART_FLAG_TX_BUSY (1 << 6) /**< a byte was written and TXC is awaited */
+
+#define UART_AUTOBAUD_IDLE 0 /**< the baudrate isn't measured */
+#define UART_AUTOBAUD_MEASURE 1 /**< the sync edges are captured */
+#define UART_AUTOBAUD_LOCKED 2 /**< the baudrate is measured, the receive update
+applies it */
+
+#define UART_PINGPONG_NONE 0xFF /**< no buffer is handed to the application */
+
+#define UART_UBRR_MAX 4095 /**< the largest value UBRR can hold */
+/******************************************************************************
+ * typedefs
+ ******************************************************************************/
+/**
+ * @brief The control block of a UART channel. It keeps together everything
+ * the update functions touch on every tick so that servicing a channel hits
+ * one small block of memory. The buffer storage is kept apart in
+ * UartSendData and UartReceiveData, and the buffers are all UART_BUFF_SIZE
+ * bytes, so only the buffer indexes are kept here.
+ */
+typedef struct
+{
+  CircBuffState_t SendBuff; /**< the UART send buffer state */
+  CircBuffState_t ReceiveBuff; /**< the UART receive buffer state */
+#if UART_CHANNEL_COUNT != 1
+  volatile uint8_t* StatusReg; /**< the UART status register */
+  volatile uint8_t* ControlReg; /**< the UART control register */
+  volatile uint8_t* DataReg; /**< the UART data register */
+#endif
+  const UartConfig_t* Config; /**< the UART configuration */
+  uint8_t Flags; /**< the UART state flags (UART_FLAG_*) */
+  uint8_t SendAddress; /**< the address waiting to be sent */
+  uint8_t SendAddressPos; /**< the send buffer position to send it at */
+  const UartConfig_t* PendingConfig; /**< the configuration to apply once the
+  line is idle, 0x00 if none */
+  uint8_t PendingConfigPos; /**< the send buffer position to apply it at */
+  volatile uint8_t Autobaud; /**< the measurement state (UART_AUTOBAUD_*), the
+  autobaud fields are shared with Uart_AutobaudCapture (an interrupt) */
+  volatile uint8_t AutobaudError; /**< set by Uart_AutobaudCapture when the
+  measured baudrate is out of range, reported by the receive update */
+  volatile uint16_t AutobaudUbrr; /**< the measured baudrate register value */
+  volatile uint8_t AutobaudDoubleSpeed; /**< 1 if it's for the U2X mode */
+  volatile uint16_t AutobaudFirst; /**< the timestamp of the first sync edge */
+  volatile uint8_t AutobaudEdges; /**< the number of sync edges captured */
+  volatile uint8_t AutobaudExpected; /**< the number of edges in the sync frame */
+  volatile uint8_t AutobaudLastPos; /**< the bit position of the last sync edge */
+} UartChannel_t;
+
+#if (UART_FRAME_MODE == 1)
+/**
+ * @brief The frame (packet) state of a UART channel. Each direction has its
+ * own pool so each free ring has a single producer and a single consumer:
+ * the receive frames are allocated by the receive path and released by the
+ * application, the send frames are allocated by the application and freed
+ * by the send path.
+ */
+typedef struct
+{
+  FramePool_t RxPool; /**< the receive frames */
+  FramePool_t TxPool; /**< the send frames */
+  FrameRing_t RxReady; /**< the received frames for the application */
+  FrameRing_t TxQueue; /**< the frames waiting to be sent */
+  FrameHandle_t RxFrame; /**< the frame being filled, FRAME_NONE if none */
+  uint8_t RxIdle; /**< the receive updates without a byte since the last one */
+  FrameHandle_t TxFrame; /**< the frame being sent, FRAME_NONE if none */
+  uint8_t TxPos; /**< the next byte of the frame being sent */
+  uint8_t RxHeld; /**< a bit per receive frame lent to the application */
+  uint8_t TxQueued; /**< a bit per send frame queued by the application */
+} UartFrameChannel_t;
+#endif
+
+#if (UART_PINGPONG_MODE == 1)
+/**
+ * @brief The double-buffered reception state of a UART channel. The receive
+ * path fills one buffer while the application processes the other one, the
+ * receive path writes Ready when Ready is UART_PINGPONG_NONE and the
+ * application writes it back to UART_PINGPONG_NONE, so it needs no locking.
+ */
+typedef struct
+{
+  uint8_t Buff[2][UART_PINGPONG_SIZE]; /**< the two linear buffers */
+  uint8_t Length[2]; /**< the number of bytes in every buffer */
+  uint8_t Fill; /**< the buffer being filled */
+  uint8_t Ready; /**< the buffer handed to the application, UART_PINGPONG_NONE
+  if none */
+  uint8_t Idle; /**< the receive updates without a byte since the last one */
+} UartPingPong_t;
+#endif
 /******************************************************************************
 * Module Variable Definitions
  ******************************************************************************/
@@ -28,360 +153,2354 @@ static uint8_t UartSendData[UART_MAX][UART_BUFF_SIZE];
  */
 static uint8_t UartReceiveData[UART_MAX][UART_BUFF_SIZE];
 
-/**
- * brief the UART send buffers structures
- */
-static CircBuff_t UartSendBuff[UART_MAX];
+/**
+ * brief the 9th bit of the bytes in the UART send data buffers, a bit per
+ * buffer position. Used by the channels configured with UART_DATA_BITS_9
+ */
+static uint8_t UartSendBit8[UART_MAX][(UART_BUFF_SIZE + 7) / 8];
+/**
+ * brief the 9th bit of the bytes in the UART receive data buffers
+ */
+static uint8_t UartReceiveBit8[UART_MAX][(UART_BUFF_SIZE + 7) / 8];
+
+/**
+ * brief the positions of the bytes received with an error in the UART receive
+ * data buffers. Used by the channels configured with UART_RX_ERROR_MARK
+ */
+static uint8_t UartReceiveError[UART_MAX][(UART_BUFF_SIZE + 7) / 8];
+
+/**
+ * brief the UART channels control blocks
+ */
+#if UART_CHANNEL_COUNT == 1
+static UartChannel_t UartChannels[UART_MAX];
+#else
+static UartChannel_t UartChannels[UART_MAX] =
+{
+  //TODO: change uint8_t according to register size
+  { { 0 }, { 0 }, (volatile uint8_t*) UCSRA, (volatile uint8_t*) UCSRB,
+    (volatile uint8_t*) UDR, 0x00, 0, 0, 0, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+};
+#endif
+
+/**
+ * brief a bit per channel that is set when data is enqueued to its send
+ * buffer and cleared when the send buffer is found empty
+ */
+static uint8_t UartSendPending;
+
+/**
+ * brief the channel Uart_ServiceAll starts from on its next call
+ */
+static Uart_t UartServiceNext;
+
+#if (UART_FRAME_MODE == 1)
+/**
+ * brief the UART receive and send frames data
+ */
+static uint8_t UartRxFrameData[UART_MAX][UART_FRAME_COUNT * UART_FRAME_SIZE];
+static uint8_t UartTxFrameData[UART_MAX][UART_FRAME_COUNT * UART_FRAME_SIZE];
+
+/**
+ * brief the UART receive and send frames lengths
+ */
+static uint8_t UartRxFrameLength[UART_MAX][UART_FRAME_COUNT];
+static uint8_t UartTxFrameLength[UART_MAX][UART_FRAME_COUNT];
+
+/**
+ * brief the UART channels frame states
+ */
+static UartFrameChannel_t UartFrameChannels[UART_MAX];
+
+/**
+ * brief compile time check that the frame rings can hold all the frames
+ */
+typedef char UartFrameCountCheck_t[(UART_FRAME_COUNT <= FRAME_POOL_MAX_FRAMES) ? 1 : -1];
+#endif
+
+#if (UART_PINGPONG_MODE == 1)
+/**
+ * brief the UART channels double-buffered reception states
+ */
+static UartPingPong_t UartPingPongs[UART_MAX];
+
+/**
+ * brief compile time check that a burst length fits its uint8_t
+ */
+typedef char UartPingPongSizeCheck_t[(UART_PINGPONG_SIZE >= 1 && UART_PINGPONG_SIZE <= 255) ? 1 : -1];
+#endif
+
+/**
+ * brief compile time check that UART_CHANNEL_COUNT matches UART_MAX
+ */
+typedef char UartChannelCountCheck_t[(UART_CHANNEL_COUNT == UART_MAX) ? 1 : -1];
+
+/**
+ * brief compile time check that every channel has a bit in UartSendPending
+ */
+typedef char UartSendPendingCheck_t[(UART_MAX <= 8) ? 1 : -1];
+
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+#if (UART_CIRCBUFF_INLINE == 0)
+static uint8_t Uart_Enqueue(CircBuffState_t * const Buff, uint8_t * const BuffData,
+  const uint8_t Data);
+static uint8_t Uart_Dequeue(CircBuffState_t * const Buff, uint8_t * const BuffData,
+  uint8_t * const Data);
+#endif
+static void Uart_BitmapWrite(uint8_t * const Map, const uint8_t Pos, const uint8_t Value);
+static uint8_t Uart_BitmapRead(const uint8_t * const Map, const uint8_t Pos);
+static void Uart_ApplyBaud(const uint16_t Ubrr, const uint8_t DoubleSpeed);
+static void Uart_ApplyConfig(const UartConfig_t * const Config);
+static void Uart_Transmit(UartChannel_t * const Channel, const uint8_t Data);
+static uint8_t Uart_TransmitDone(UartChannel_t * const Channel);
+static void Uart_SwitchConfig(UartChannel_t * const Channel,
+  const UartConfig_t * const Config);
+static void Uart_SendChannel(const Uart_t Uart, UartChannel_t * const Channel);
+static void Uart_ReceiveChannel(const Uart_t Uart, UartChannel_t * const Channel);
+static void Uart_ReceiveFlow(const Uart_t Uart, UartChannel_t * const Channel,
+  const uint8_t Stop);
+static void Uart_ReceiveResume(const Uart_t Uart, UartChannel_t * const Channel);
+#if (UART_FRAME_MODE == 1)
+static void Uart_FrameReceive(const Uart_t Uart, UartChannel_t * const Channel,
+  const uint8_t Data);
+static void Uart_FrameIdle(const Uart_t Uart, UartChannel_t * const Channel);
+static uint8_t Uart_FrameSend(const Uart_t Uart, uint8_t * const Data);
+#endif
+#if (UART_PINGPONG_MODE == 1)
+static uint8_t Uart_PingPongSwap(UartPingPong_t * const PingPong);
+static void Uart_PingPongReceive(const Uart_t Uart, UartChannel_t * const Channel,
+  const uint8_t Data);
+static void Uart_PingPongIdle(const Uart_t Uart, UartChannel_t * const Channel);
+#endif
+
+/******************************************************************************
+ * Private functions definitions
+ ******************************************************************************/
+#if (UART_CIRCBUFF_INLINE == 0)
+/******************************************************************************
+* Function : Uart_Enqueue()
+*//**
+* \b Description:
+* Utility function is used to keep a single copy of the buffer enqueue when
+* the inline fast path is disabled (UART_CIRCBUFF_INLINE).
+*
+* @param Buff a valid pointer to the buffer state
+* @param BuffData the buffer memory, UART_BUFF_SIZE bytes
+* @param Data the byte to enqueue
+* @return uint8_t 1 if the byte is stored and 0 otherwise
+*
+******************************************************************************/
+static uint8_t
+Uart_Enqueue(CircBuffState_t * const Buff, uint8_t * const BuffData,
+  const uint8_t Data)
+{
+  return CircBuff_EnqueueSized(Buff, BuffData, UART_BUFF_SIZE, Data);
+}
+
+/******************************************************************************
+* Function : Uart_Dequeue()
+*//**
+* \b Description:
+* Utility function is used to keep a single copy of the buffer dequeue when
+* the inline fast path is disabled (UART_CIRCBUFF_INLINE).
+*
+* @param Buff a valid pointer to the buffer state
+* @param BuffData the buffer memory, UART_BUFF_SIZE bytes
+* @param Data a valid pointer to store the dequeued byte in
+* @return uint8_t 1 if there's a valid byte returned, 0 otherwise
+*
+******************************************************************************/
+static uint8_t
+Uart_Dequeue(CircBuffState_t * const Buff, uint8_t * const BuffData,
+  uint8_t * const Data)
+{
+  return CircBuff_DequeueSized(Buff, BuffData, UART_BUFF_SIZE, Data);
+}
+#endif
+
+/******************************************************************************
+* Function : Uart_BitmapWrite()
+*//**
+* \b Description:
+* Utility function is used to set or clear the bit of a buffer position in a
+* side bitmap.
+*
+* @param Map a valid pointer to the bitmap
+* @param Pos the buffer position
+* @param Value the bit value, 0 or 1
+* @return void
+*******************************************************************************/
+static void
+Uart_BitmapWrite(uint8_t * const Map, const uint8_t Pos, const uint8_t Value)
+{
+  uint8_t Mask = (uint8_t) (1 << (Pos & 0x07));
+
+  if(Value != 0) Map[Pos >> 3] |= Mask;
+  else Map[Pos >> 3] &= (uint8_t) ~Mask;
+}
+
+/******************************************************************************
+* Function : Uart_BitmapRead()
+*//**
+* \b Description:
+* Utility function is used to read the bit of a buffer position in a side
+* bitmap.
+*
+* @param Map a valid pointer to the bitmap
+* @param Pos the buffer position
+* @return uint8_t the bit value, 0 or 1
+*******************************************************************************/
+static uint8_t
+Uart_BitmapRead(const uint8_t * const Map, const uint8_t Pos)
+{
+  return (Map[Pos >> 3] >> (Pos & 0x07)) & 0x01;
+}
+
+/******************************************************************************
+* Function : Uart_ApplyBaud()
+*//**
+* \b Description:
+* Utility function is used to set the baudrate register and the double speed
+* (U2X) bit of a Uart peripheral.
+*
+* @param Ubrr the baudrate register value
+* @param DoubleSpeed 1 for the double speed mode (8 samples per bit), 0 for
+* the normal mode (16 samples per bit)
+* @return void
+*
+* @see Uart_ApplyConfig
+* @see Uart_ReceiveChannel
+*******************************************************************************/
+static void
+Uart_ApplyBaud(const uint16_t Ubrr, const uint8_t DoubleSpeed)
+{
+  *UBRRH = (uint8_t) (Ubrr >> 8);
+  *UBRRL = (uint8_t) (Ubrr & 0xFF);
+
+  //TXC is written as 0 so the write doesn't clear it
+  *UCSRA = (uint8_t) ((*UCSRA & (1 << MPCM)) | (DoubleSpeed << U2X));
+}
+
+/******************************************************************************
+* Function : Uart_ApplyConfig()
+*//**
+* \b Description:
+* Utility function is used to set up the line settings of a Uart peripheral,
+* the send and receive buffers are not touched.
+* PRE-CONDITION: No frame is being sent <br>
+*
+* @param Config a valid pointer to the channel configuration
+* @return void
+*
+* @see Uart_Init
+* @see Uart_Reconfigure
+*******************************************************************************/
+static void
+Uart_ApplyConfig(const UartConfig_t * const Config)
+{
+  uint16_t Ubrr = (uint16_t) (((SYSTEM_FREQ)/16/Config->Baudrate)-1);
+  //enable UART and interrupt events
+  uint8_t Ucsrb = 1 << TXEN | 1 << RXEN;
+  // When the function writes to the UCSRC Register, the URSEL bit
+  // (MSB) must be set due to the sharing of I/O location by UBRRH
+  //and UCSRC.
+  uint8_t Ucsrc = 1 << URSEL;
+
+  if(Config->DataBits == UART_DATA_BITS_9 || Config->Mpcm == UART_MPCM_ON)
+    {
+      Ucsrb |= 1 << UCSZ2;
+      Ucsrc |= 1 << UCSZ0 | 1 << UCSZ1;
+    }
+  else
+    {
+      Ucsrc |= (uint8_t) (Config->DataBits << UCSZ0);
+    }
+
+  if(Config->StopBit == UART_STOP_BIT_2)
+    {
+      Ucsrc |= 1 << USBS;
+    }
+
+  if(Config->Parity == UART_PARTIY_EVEN)
+    {
+      Ucsrc |= 1 << UPM1;
+    }
+  else if(Config->Parity == UART_PARTIY_ODD)
+    {
+      Ucsrc |= 1 << UPM1 | 1 << UPM0;
+    }
+
+  //9-bit frames, the 9th bit marks the address frames. The data
+  //frames are ignored by the hardware until our address is received
+  *UCSRA = (Config->Mpcm == UART_MPCM_ON) ? (1 << MPCM) : 0;
+
+  //baud rate
+  Uart_ApplyBaud(Ubrr, 0);
+
+  *UCSRB = Ucsrb;
+  *UCSRC = Ucsrc;
+}
+
+/******************************************************************************
+* Function : Uart_Transmit()
+*//**
+* \b Description:
+* Utility function is used to write a byte to the data register of a channel.
+* It clears TXC so that TXC marks the end of the last byte written, and for a
+* half-duplex channel it drives the transceiver before the first byte. <br>
+* PRE-CONDITION: The data register is empty (UDRE is set) <br>
+*
+* @param Channel a valid pointer to the channel control block
+* @param Data the byte to send
+* @return void
+*
+* @see Uart_SendChannel
+*******************************************************************************/
+static void
+Uart_Transmit(UartChannel_t * const Channel, const uint8_t Data)
+{
+  if(Channel->Config->DriverEnable != 0x00 &&
+     !(Channel->Flags & UART_FLAG_DE_ASSERTED))
+    {
+      Channel->Config->DriverEnable(1);
+      Channel->Flags |= UART_FLAG_DE_ASSERTED;
+    }
+
+  //TXC is cleared by writing 1 to it, U2X and MPCM are kept
+  UART_STATUS_REG(Channel) =
+    (UART_STATUS_REG(Channel) & (1 << U2X | 1 << MPCM)) | 1 << TXC;
+  Channel->Flags |= UART_FLAG_TX_BUSY;
+
+  UART_DATA_REG(Channel) = Data;
+}
+
+/******************************************************************************
+* Function : Uart_TransmitDone()
+*//**
+* \b Description:
+* Utility function is used to check if the last byte written to a channel
+* has left the shift register (TXC), and then to release the transceiver of
+* a half-duplex channel.
+*
+* @param Channel a valid pointer to the channel control block
+* @return uint8_t 1 if the line is idle, 0 if a byte is still being sent
+*
+* @see Uart_Transmit
+*******************************************************************************/
+static uint8_t
+Uart_TransmitDone(UartChannel_t * const Channel)
+{
+  //wait for the last stop bit to leave
+  if(Channel->Flags & UART_FLAG_TX_BUSY)
+    {
+      if(!(UART_STATUS_REG(Channel) & (1 << TXC))) return 0;
+
+      Channel->Flags &= (uint8_t) ~UART_FLAG_TX_BUSY;
+    }
+
+  //release the bus
+  if(Channel->Flags & UART_FLAG_DE_ASSERTED)
+    {
+      Channel->Config->DriverEnable(0);
+      Channel->Flags &= (uint8_t) ~UART_FLAG_DE_ASSERTED;
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : Uart_SwitchConfig()
+*//**
+* \b Description:
+* Utility function is used to apply new settings to an idle channel. When the
+* flow control or the transceiver hook changes, the flow control state is
+* cleared and the pins are driven as Uart_Init leaves them. <br>
+* PRE-CONDITION: The line is idle (Uart_TransmitDone returned 1) <br>
+*
+* @param Channel a valid pointer to the channel control block
+* @param Config a valid pointer to the new configuration of the channel
+* @return void
+*
+* @see Uart_Reconfigure
+*******************************************************************************/
+static void
+Uart_SwitchConfig(UartChannel_t * const Channel,
+  const UartConfig_t * const Config)
+{
+  const UartConfig_t * const Old = Channel->Config;
+
+  if(Config->FlowControl != Old->FlowControl || Config->RtsWrite != Old->RtsWrite)
+    {
+      Channel->Flags &= (uint8_t) ~(UART_FLAG_TX_STOPPED | UART_FLAG_RX_STOPPED |
+                                    UART_FLAG_SEND_XOFF | UART_FLAG_SEND_XON);
+
+      if(Config->FlowControl == UART_FLOW_CONTROL_RTS_CTS)
+        {
+          Config->RtsWrite(1);
+        }
+    }
+
+  if(Config->DriverEnable != Old->DriverEnable && Config->DriverEnable != 0x00)
+    {
+      Config->DriverEnable(0);
+    }
+
+  Uart_ApplyConfig(Config);
+  Channel->Config = Config;
+  Channel->ReceiveBuff.Policy = (uint8_t) Config->ReceivePolicy;
+}
+
+/******************************************************************************
+* Function : Uart_SendChannel()
+*//**
+* \b Description:
+* Utility function is used to send the next byte (if existed) of a channel,
+* it clears the channel pending bit once its send buffer is found empty and
+* the last byte has left the shift register. Then the line is idle so the
+* transceiver of a half-duplex channel is released. The transceiver is also
+* released while the peer holds the data back with XOFF or CTS. A pending
+* reconfiguration is applied once the data queued before it has left, even
+* if the data queued after it is held back.
+*
+* @param Uart the Uart Id 
+* @param Channel a valid pointer to the channel control block
+* @return void
+*
+* @see Uart_SendUpdate
+*******************************************************************************/
+static void
+Uart_SendChannel(const Uart_t Uart, UartChannel_t * const Channel)
+{
+  uint8_t Result;
+  uint8_t Data;
+  uint8_t Pos;
+  
+  //flow control characters go first
+  if(Channel->Flags & (UART_FLAG_SEND_XOFF | UART_FLAG_SEND_XON))
+    {
+      if(UART_STATUS_REG(Channel) & (1<<UDRE))
+        {
+          //a flow control character is a data frame, even right after an
+          //address on an addressed bus
+          if(Channel->Config->Mpcm == UART_MPCM_ON ||
+             Channel->Config->DataBits == UART_DATA_BITS_9)
+            {
+              UART_CONTROL_REG(Channel) &= (uint8_t) ~(1 << TXB8);
+            }
+
+          if(Channel->Flags & UART_FLAG_SEND_XOFF)
+            {
+              Uart_Transmit(Channel, UART_XOFF);
+              Channel->Flags &= (uint8_t) ~UART_FLAG_SEND_XOFF;
+            }
+          else
+            {
+              Uart_Transmit(Channel, UART_XON);
+              Channel->Flags &= (uint8_t) ~UART_FLAG_SEND_XON;
+            }
+        }
+      return;
+    }
+
+  //the settings change at the send buffer position recorded by
+  //Uart_Reconfigure, an address queued at that position goes first
+  if(Channel->PendingConfig != 0x00 &&
+     Channel->SendBuff.Rear == Channel->PendingConfigPos &&
+     !((Channel->Flags & UART_FLAG_SEND_ADDRESS) &&
+       Channel->SendAddressPos == Channel->PendingConfigPos)
+#if (UART_FRAME_MODE == 1)
+     && UartFrameChannels[UART_CHANNEL(Uart)].TxFrame == FRAME_NONE
+#endif
+     )
+    {
+      if(Uart_TransmitDone(Channel) == 0) return;
+
+      Uart_SwitchConfig(Channel, Channel->PendingConfig);
+      Channel->PendingConfig = 0x00;
+      return;
+    }
+
+  //the peer holds the data back, the bus is released meanwhile
+  if((Channel->Flags & UART_FLAG_TX_STOPPED) ||
+     (Channel->Config->FlowControl == UART_FLOW_CONTROL_RTS_CTS &&
+      Channel->Config->CtsRead() == 0))
+    {
+      (void) Uart_TransmitDone(Channel);
+      return;
+    }
+
+  //the address goes out once the data queued before it has been sent
+  if((Channel->Flags & UART_FLAG_SEND_ADDRESS) &&
+     Channel->SendBuff.Rear == Channel->SendAddressPos)
+    {
+      if(UART_STATUS_REG(Channel) & (1<<UDRE))
+        {
+          UART_CONTROL_REG(Channel) |= 1 << TXB8;
+          Uart_Transmit(Channel, Channel->SendAddress);
+          Channel->Flags &= (uint8_t) ~UART_FLAG_SEND_ADDRESS;
+        }
+      return;
+    }
+
+  Pos = Channel->SendBuff.Rear;
+  Result = 0;
+  //the data queued after a pending reconfiguration waits for it
+  if(Channel->PendingConfig == 0x00 || Pos != Channel->PendingConfigPos)
+    {
+      Result = UART_DEQUEUE(&Channel->SendBuff, UART_SEND_DATA(Uart), &Data);
+    }
+  //only the bytes of the send buffer are traced, not the frame bytes
+  UART_BYTE_TRACE_MARK(Queued, Result);
+#if (UART_FRAME_MODE == 1)
+  //the queued frames go once the send buffer is empty
+  if(Result == 0) Result = Uart_FrameSend(Uart, &Data);
+#endif
+  if(Result == 0)
+    {
+      if(Uart_TransmitDone(Channel) == 0) return;
+
+      UartSendPending &= (uint8_t) ~(1 << UART_CHANNEL(Uart));
+    }
+  else
+    {
+      //Transmit buffer empty ?
+      if(UART_STATUS_REG(Channel) & (1<<UDRE))
+        {
+          //the 9th bit of a data frame, always 0 on an addressed bus
+          if(Channel->Config->Mpcm == UART_MPCM_ON)
+            {
+              UART_CONTROL_REG(Channel) &= (uint8_t) ~(1 << TXB8);
+            }
+          else if(Channel->Config->DataBits == UART_DATA_BITS_9)
+            {
+              if(Uart_BitmapRead(UartSendBit8[UART_CHANNEL(Uart)], Pos))
+                UART_CONTROL_REG(Channel) |= 1 << TXB8;
+              else
+                UART_CONTROL_REG(Channel) &= (uint8_t) ~(1 << TXB8);
+            }
+          Uart_Transmit(Channel, Data);
+          UART_BYTE_TRACE_OUT(Uart, UART_TRACE_TX_QUEUE, Pos, Queued);
+        }
+      else
+        {
+          Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_UPDATE_ID, UART_E_TB_NEMPTY);
+        }
+    }
+
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveChannel()
+*//**
+* \b Description:
+* Utility function is used to receive a byte (if existed) of a channel.
+*
+* @param Uart the Uart Id 
+* @param Channel a valid pointer to the channel control block
+* @return void
+*
+* @see Uart_ReceiveUpdate
+*******************************************************************************/
+static void
+Uart_ReceiveChannel(const Uart_t Uart, UartChannel_t * const Channel)
+{
+  uint8_t Result;
+  uint8_t Data;
+  uint8_t Pos;
+  uint8_t error = 0;
+
+  //Uart_AutobaudCapture runs in an interrupt, its errors are reported and
+  //its baudrate is applied here so the registers are only written by the task
+  if(Channel->AutobaudError != 0)
+    {
+      Channel->AutobaudError = 0;
+      Det_ReportError(UART_MODULE_ID, Uart, UART_AUTOBAUD_CAPTURE_ID, UART_E_AUTOBAUD);
+    }
+
+  if(Channel->Autobaud == UART_AUTOBAUD_LOCKED)
+    {
+      //a frame received at the old baudrate is garbage
+      if(UART_STATUS_REG(Channel) & (1 << RXC)) Data = UART_DATA_REG(Channel);
+
+      Uart_ApplyBaud(Channel->AutobaudUbrr, Channel->AutobaudDoubleSpeed);
+      Channel->Autobaud = UART_AUTOBAUD_IDLE;
+      return;
+    }
+
+  //received something ?
+  if(UART_STATUS_REG(Channel) & (1 << RXC))
+    {
+      //the frames received before the baudrate is applied are garbage
+      if(Channel->Autobaud != UART_AUTOBAUD_IDLE)
+        {
+          Data = UART_DATA_REG(Channel);
+          return;
+        }
+
+      //error bits are valid until the receive buffer (UDR) is read
+      if(UART_STATUS_REG(Channel) & (1 << FE))
+        {
+          Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_FRAME);
+          error = 1;
+        }
+
+      if(UART_STATUS_REG(Channel) & (1 << DOR))
+        {
+          Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_OVERRUN);
+          error = 1;              
+        }
+
+      if(UART_STATUS_REG(Channel) & (1 << PE))
+        {
+          Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_PARITY);
+          error = 1;
+        }
+
+      if(error == 0 && Channel->Config->Mpcm == UART_MPCM_ON &&
+         (UART_CONTROL_REG(Channel) & (1 << RXB8)))
+        {
+          //an address frame, listen to the data frames only if it's ours.
+          //TXC is written as 0 so the write doesn't clear it
+          Data = UART_DATA_REG(Channel);
+          if(Data == Channel->Config->Address)
+            {
+              UART_STATUS_REG(Channel) &= (uint8_t) ~(1 << MPCM | 1 << TXC);
+            }
+          else
+            {
+              UART_STATUS_REG(Channel) =
+                (UART_STATUS_REG(Channel) & (uint8_t) ~(1 << TXC)) | 1 << MPCM;
+            }
+        }
+      else if(error == 0 || Channel->Config->RxErrorMode == UART_RX_ERROR_MARK)
+        {
+          //the 9th bit must be read before the data register
+          uint8_t Bit8 = UART_CONTROL_REG(Channel) & (1 << RXB8);
+          Data = UART_DATA_REG(Channel);
+
+          if(error == 0 &&
+             Channel->Config->FlowControl == UART_FLOW_CONTROL_XON_XOFF &&
+             (Data == UART_XOFF || Data == UART_XON))
+            {
+              if(Data == UART_XOFF) Channel->Flags |= UART_FLAG_TX_STOPPED;
+              else Channel->Flags &= (uint8_t) ~UART_FLAG_TX_STOPPED;
+              return;
+            }
+
+#if (UART_FRAME_MODE == 1)
+          if(Channel->Config->RxMode == UART_RX_MODE_FRAME)
+            {
+              if(error == 0) Uart_FrameReceive(Uart, Channel, Data);
+              return;
+            }
+#endif
+
+#if (UART_PINGPONG_MODE == 1)
+          if(Channel->Config->RxMode == UART_RX_MODE_PINGPONG)
+            {
+              if(error == 0) Uart_PingPongReceive(Uart, Channel, Data);
+              return;
+            }
+#endif
+
+          Pos = Channel->ReceiveBuff.Front;
+          Result = UART_ENQUEUE(&Channel->ReceiveBuff, UART_RECEIVE_DATA(Uart), Data);
+          UART_BYTE_TRACE_IN(Uart, UART_TRACE_RX_QUEUE, Pos, Result);
+
+          if(Result == 1 && Channel->Config->DataBits == UART_DATA_BITS_9)
+            {
+              Uart_BitmapWrite(UartReceiveBit8[UART_CHANNEL(Uart)], Pos, Bit8);
+            }
+          if(Result == 1 && Channel->Config->RxErrorMode == UART_RX_ERROR_MARK)
+            {
+              Uart_BitmapWrite(UartReceiveError[UART_CHANNEL(Uart)], Pos, error);
+            }
+          if(Result == 0 && Channel->Config->ReceivePolicy == CIRCBUFF_REPORT)
+            {
+              Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_RX_OVERFLOW);
+            }
+
+          if(UART_COUNT(&Channel->ReceiveBuff) >= UART_RX_HIGH_WATERMARK)
+            {
+              Uart_ReceiveFlow(Uart, Channel, 1);
+            }
+        }
+      else
+        {
+          //clear RXC flag
+          Data = UART_DATA_REG(Channel);
+        }
+    }
+#if (UART_FRAME_MODE == 1) || (UART_PINGPONG_MODE == 1)
+  else
+    {
+#if (UART_FRAME_MODE == 1)
+      Uart_FrameIdle(Uart, Channel);
+#endif
+#if (UART_PINGPONG_MODE == 1)
+      Uart_PingPongIdle(Uart, Channel);
+#endif
+    }
+#endif
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveFlow()
+*//**
+* \b Description:
+* Utility function is used to ask the peer to stop sending, or to allow it to
+* send again, with the flow control of the channel. It does nothing if the
+* peer is already in the requested state.
+*
+* @param Uart the Uart Id 
+* @param Channel a valid pointer to the channel control block
+* @param Stop 1 to stop the peer, 0 to resume it
+* @return void
+*
+* @see Uart_ReceiveChannel
+* @see Uart_ReceiveResume
+*******************************************************************************/
+static void
+Uart_ReceiveFlow(const Uart_t Uart, UartChannel_t * const Channel,
+  const uint8_t Stop)
+{
+  if(Channel->Config->FlowControl == UART_FLOW_CONTROL_NONE ||
+     ((Channel->Flags & UART_FLAG_RX_STOPPED) != 0) == (Stop != 0)) return;
+
+  if(Stop) Channel->Flags |= UART_FLAG_RX_STOPPED;
+  else Channel->Flags &= (uint8_t) ~UART_FLAG_RX_STOPPED;
+
+  if(Channel->Config->FlowControl == UART_FLOW_CONTROL_XON_XOFF)
+    {
+      Channel->Flags &= (uint8_t) ~(UART_FLAG_SEND_XOFF | UART_FLAG_SEND_XON);
+      Channel->Flags |= Stop ? UART_FLAG_SEND_XOFF : UART_FLAG_SEND_XON;
+      UartSendPending |= (uint8_t) (1 << UART_CHANNEL(Uart));
+    }
+  else
+    {
+      Channel->Config->RtsWrite(Stop ? 0 : 1);
+    }
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveResume()
+*//**
+* \b Description:
+* Utility function is used after the application consumed received data to
+* allow the peer to send again once the receive buffer drained below the low
+* watermark.
+*
+* @param Uart the Uart Id 
+* @param Channel a valid pointer to the channel control block
+* @return void
+*
+* @see Uart_ReceiveChannel
+*******************************************************************************/
+static void
+Uart_ReceiveResume(const Uart_t Uart, UartChannel_t * const Channel)
+{
+  if(Channel->Config->RxMode == UART_RX_MODE_RING &&
+     UART_COUNT(&Channel->ReceiveBuff) <= UART_RX_LOW_WATERMARK)
+    {
+      Uart_ReceiveFlow(Uart, Channel, 0);
+    }
+}
+
+#if (UART_FRAME_MODE == 1)
+/******************************************************************************
+* Function : Uart_FrameReceive()
+*//**
+* \b Description:
+* Utility function is used to append a received byte to the frame being
+* filled. The frame is handed to the application when it's full or when the
+* byte is the frame end byte of the channel. The peer is asked to stop
+* sending once the last free frame is being filled, and a byte received
+* while all the frames are held by the application is lost like with a full
+* receive buffer.
+*
+* @param Uart the Uart Id 
+* @param Channel a valid pointer to the channel control block
+* @param Data the received byte
+* @return void
+*
+* @see Uart_ReceiveFrame
+*******************************************************************************/
+static void
+Uart_FrameReceive(const Uart_t Uart, UartChannel_t * const Channel,
+  const uint8_t Data)
+{
+  UartFrameChannel_t * const Frames = &UartFrameChannels[UART_CHANNEL(Uart)];
+
+  if(Frames->RxFrame == FRAME_NONE)
+    {
+      Frames->RxFrame = FramePool_Alloc(&Frames->RxPool);
+
+      if(Frames->RxFrame == FRAME_NONE)
+        {
+          Channel->ReceiveBuff.Lost++;
+          if(Channel->Config->ReceivePolicy == CIRCBUFF_REPORT)
+            {
+              Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_RX_OVERFLOW);
+            }
+          return;
+        }
+
+      FramePool_SetLength(&Frames->RxPool, Frames->RxFrame, 0);
+
+      if(FramePool_GetFree(&Frames->RxPool) == 0)
+        {
+          Uart_ReceiveFlow(Uart, Channel, 1);
+        }
+    }
+
+  uint8_t Length = FramePool_GetLength(&Frames->RxPool, Frames->RxFrame);
+
+  FramePool_Data(&Frames->RxPool, Frames->RxFrame)[Length++] = Data;
+  FramePool_SetLength(&Frames->RxPool, Frames->RxFrame, Length);
+  Frames->RxIdle = 0;
+
+  if(Length == UART_FRAME_SIZE || Data == Channel->Config->FrameEnd)
+    {
+      FrameRing_Enqueue(&Frames->RxReady, Frames->RxFrame);
+      Frames->RxFrame = FRAME_NONE;
+    }
+}
+
+/******************************************************************************
+* Function : Uart_FrameIdle()
+*//**
+* \b Description:
+* Utility function is used on a receive update without a received byte to
+* hand a partly filled frame to the application once the line was idle for
+* FrameIdleTicks updates.
+*
+* @param Uart the Uart Id 
+* @param Channel a valid pointer to the channel control block
+* @return void
+*
+* @see Uart_FrameReceive
+*******************************************************************************/
+static void
+Uart_FrameIdle(const Uart_t Uart, UartChannel_t * const Channel)
+{
+  UartFrameChannel_t * const Frames = &UartFrameChannels[UART_CHANNEL(Uart)];
+
+  if(Frames->RxFrame == FRAME_NONE || Channel->Config->FrameIdleTicks == 0) return;
+
+  Frames->RxIdle++;
+  if(Frames->RxIdle >= Channel->Config->FrameIdleTicks)
+    {
+      FrameRing_Enqueue(&Frames->RxReady, Frames->RxFrame);
+      Frames->RxFrame = FRAME_NONE;
+    }
+}
+
+/******************************************************************************
+* Function : Uart_FrameSend()
+*//**
+* \b Description:
+* Utility function is used to get the next byte of the queued frames. A frame
+* is given back to the send pool after its last byte.
+*
+* @param Uart the Uart Id 
+* @param Data a pointer to store the byte in
+* @return uint8_t 1 if a byte is got, 0 if no frame is queued
+*
+* @see Uart_SendFrame
+*******************************************************************************/
+static uint8_t
+Uart_FrameSend(const Uart_t Uart, uint8_t * const Data)
+{
+  UartFrameChannel_t * const Frames = &UartFrameChannels[UART_CHANNEL(Uart)];
+
+  while(Frames->TxFrame == FRAME_NONE)
+    {
+      if(FrameRing_Dequeue(&Frames->TxQueue, &Frames->TxFrame) == 0) return 0;
+
+      Frames->TxPos = 0;
+
+      //an empty frame has nothing to send
+      if(FramePool_GetLength(&Frames->TxPool, Frames->TxFrame) == 0)
+        {
+          FramePool_Free(&Frames->TxPool, Frames->TxFrame);
+          Frames->TxFrame = FRAME_NONE;
+        }
+    }
+
+  *Data = FramePool_Data(&Frames->TxPool, Frames->TxFrame)[Frames->TxPos++];
+
+  if(Frames->TxPos == FramePool_GetLength(&Frames->TxPool, Frames->TxFrame))
+    {
+      FramePool_Free(&Frames->TxPool, Frames->TxFrame);
+      Frames->TxFrame = FRAME_NONE;
+    }
+
+  return 1;
+}
+#endif
+
+#if (UART_PINGPONG_MODE == 1)
+/******************************************************************************
+* Function : Uart_PingPongSwap()
+*//**
+* \b Description:
+* Utility function is used to hand the buffer being filled to the application
+* and to continue filling the other one, if the application released it.
+*
+* @param PingPong a valid pointer to the channel double-buffered state
+* @return uint8_t 1 if the buffers are swapped, 0 if the application still
+* holds the other buffer
+*
+* @see Uart_ReleaseBurst
+*******************************************************************************/
+static uint8_t
+Uart_PingPongSwap(UartPingPong_t * const PingPong)
+{
+  if(CIRCBUFF_LOAD_ACQUIRE(PingPong->Ready) != UART_PINGPONG_NONE) return 0;
+
+  CIRCBUFF_STORE_RELEASE(PingPong->Ready, PingPong->Fill);
+  PingPong->Fill ^= 1;
+  PingPong->Length[PingPong->Fill] = 0;
+  PingPong->Idle = 0;
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : Uart_PingPongReceive()
+*//**
+* \b Description:
+* Utility function is used to append a received byte to the buffer being
+* filled, the buffers are swapped once it's full. The peer is asked to stop
+* sending once the buffer being filled reaches UART_PINGPONG_HIGH_WATERMARK
+* while the application holds the other one, and a byte received while both
+* buffers are full is lost like with a full receive buffer.
+*
+* @param Uart the Uart Id 
+* @param Channel a valid pointer to the channel control block
+* @param Data the received byte
+* @return void
+*
+* @see Uart_ReceiveBurst
+*******************************************************************************/
+static void
+Uart_PingPongReceive(const Uart_t Uart, UartChannel_t * const Channel,
+  const uint8_t Data)
+{
+  UartPingPong_t * const PingPong = &UartPingPongs[UART_CHANNEL(Uart)];
+
+  //a full buffer is handed over as soon as the other one is released
+  if(PingPong->Length[PingPong->Fill] == UART_PINGPONG_SIZE &&
+     Uart_PingPongSwap(PingPong) == 0)
+    {
+      Channel->ReceiveBuff.Lost++;
+      if(Channel->Config->ReceivePolicy == CIRCBUFF_REPORT)
+        {
+          Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_RX_OVERFLOW);
+        }
+      return;
+    }
+
+  PingPong->Buff[PingPong->Fill][PingPong->Length[PingPong->Fill]++] = Data;
+  PingPong->Idle = 0;
+
+  if(PingPong->Length[PingPong->Fill] == UART_PINGPONG_SIZE)
+    {
+      Uart_PingPongSwap(PingPong);
+    }
+
+  if(PingPong->Length[PingPong->Fill] >= UART_PINGPONG_HIGH_WATERMARK &&
+     CIRCBUFF_LOAD_ACQUIRE(PingPong->Ready) != UART_PINGPONG_NONE)
+    {
+      Uart_ReceiveFlow(Uart, Channel, 1);
+    }
+}
+
+/******************************************************************************
+* Function : Uart_PingPongIdle()
+*//**
+* \b Description:
+* Utility function is used on a receive update without a received byte to
+* hand a partly filled buffer to the application once the line was idle for
+* FrameIdleTicks updates, or a full one. It's retried every update until the
+* application released the other buffer.
+*
+* @param Uart the Uart Id 
+* @param Channel a valid pointer to the channel control block
+* @return void
+*
+* @see Uart_PingPongReceive
+*******************************************************************************/
+static void
+Uart_PingPongIdle(const Uart_t Uart, UartChannel_t * const Channel)
+{
+  UartPingPong_t * const PingPong = &UartPingPongs[UART_CHANNEL(Uart)];
+
+  if(PingPong->Length[PingPong->Fill] == 0) return;
+
+  //a full buffer waits for the application to release the other one
+  if(PingPong->Length[PingPong->Fill] == UART_PINGPONG_SIZE)
+    {
+      Uart_PingPongSwap(PingPong);
+    }
+  else if(Channel->Config->FrameIdleTicks != 0)
+    {
+      if(PingPong->Idle < Channel->Config->FrameIdleTicks) PingPong->Idle++;
+      if(PingPong->Idle >= Channel->Config->FrameIdleTicks)
+        {
+          Uart_PingPongSwap(PingPong);
+        }
+    }
+}
+#endif
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Uart_Init()
+*//**
+* \b Description:
+* This function is used to initialize the Uart based on the configuration
+* table defined in uart_cfg file. <br>
+* PRE-CONDITION: Configuration table needs to populated (sizeof > 0) <br>
+* PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+* PRE-CONDITION: The UART DIO pins are configured properly. <br>
+* POST-CONDITION: The Uart peripherals are set up with the configuration 
+* settings.<br>
+* @param Config is a pointer to the configuration table that
+* contains the initialization for the peripheral.
+* @return void
+*
+* \b Example:
+* @code
+* const UartConfig_t *UartConfig = Uart_ConfigGet();
+* Uart_Init(UartConfig);
+* @endcode
+* @see Uart_ConfigGet
+*******************************************************************************/
+extern void 
+Uart_Init(const UartConfig_t * const Config)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Config != 0x00))
+    {
+      Det_ReportError(UART_MODULE_ID, 0, UART_INIT_ID, UART_E_PARAM);
+      return;
+    }
+#endif
+
+  UartSendPending = 0;
+  UartServiceNext = UART_0;
+
+  for(uint8_t i = 0; i < UART_MAX; i++)
+    {
+      UartChannels[i].SendBuff = CircBuff_CreateState(CIRCBUFF_DROP_NEW);
+      UartChannels[i].ReceiveBuff = CircBuff_CreateState(Config[i].ReceivePolicy);
+      UartChannels[i].Config = &Config[i];
+      UartChannels[i].Flags = 0;
+      UartChannels[i].PendingConfig = 0x00;
+      UartChannels[i].Autobaud = UART_AUTOBAUD_IDLE;
+      UartChannels[i].AutobaudError = 0;
+
+#if (UART_FRAME_MODE == 1)
+      FramePool_Create(&UartFrameChannels[i].RxPool, UartRxFrameData[i],
+        UartRxFrameLength[i], UART_FRAME_SIZE, UART_FRAME_COUNT);
+      FramePool_Create(&UartFrameChannels[i].TxPool, UartTxFrameData[i],
+        UartTxFrameLength[i], UART_FRAME_SIZE, UART_FRAME_COUNT);
+      FrameRing_Reset(&UartFrameChannels[i].RxReady);
+      FrameRing_Reset(&UartFrameChannels[i].TxQueue);
+      UartFrameChannels[i].RxFrame = FRAME_NONE;
+      UartFrameChannels[i].RxIdle = 0;
+      UartFrameChannels[i].TxFrame = FRAME_NONE;
+      UartFrameChannels[i].TxPos = 0;
+      UartFrameChannels[i].RxHeld = 0;
+      UartFrameChannels[i].TxQueued = 0;
+#endif
+
+#if (UART_PINGPONG_MODE == 1)
+      UartPingPongs[i].Length[0] = 0;
+      UartPingPongs[i].Length[1] = 0;
+      UartPingPongs[i].Fill = 0;
+      UartPingPongs[i].Ready = UART_PINGPONG_NONE;
+      UartPingPongs[i].Idle = 0;
+#endif
+
+      if(Config[i].FlowControl == UART_FLOW_CONTROL_RTS_CTS)
+        {
+          Config[i].RtsWrite(1);
+        }
+
+      if(Config[i].DriverEnable != 0x00)
+        {
+          Config[i].DriverEnable(0);
+        }
+
+      *UBRRL = 0;
+      *UBRRH = 0;
+      *UCSRB = 0;
+      *UCSRC = 0;
+
+      Uart_ApplyConfig(&Config[i]);
+    }
+}
+
+/******************************************************************************
+* Function : Uart_SendUpdate()
+*//**
+* \b Description:
+* This function is used to send the next byte (if existed) in the UART send 
+* data buffers. <br>
+* PRE-CONDITION: Uart_Init called properly <br>
+* POST-CONDITION: The next byte (if existed) in the UART data buffers is sent <br>
+* @param Uart the Uart Id 
+* @return void
+*
+* @see Uart_Init
+*******************************************************************************/
+extern void
+Uart_SendUpdate(const Uart_t Uart)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_UPDATE_ID, UART_E_PARAM);
+      return;
+    }
+#endif
+
+  UART_TRACE_ENTER(Start);
+  Uart_SendChannel(Uart, &UartChannels[UART_CHANNEL(Uart)]);
+  UART_TRACE_EXIT(Uart, UART_TRACE_SEND_UPDATE, Start);
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveUpdate()
+*//**
+* \b Description:
+* This function is used to receive a byte (if existed) in the UART receive 
+* data registers and store them in the UART receive buffers. <br>
+* PRE-CONDITION: Uart_Init called properly <br>
+* POST-CONDITION: The next byte (if existed) in the UART data registers is 
+* received <br>
+* @param Uart the Uart Id 
+* @return void
+*
+* @see Uart_Init
+*******************************************************************************/
+extern void
+Uart_ReceiveUpdate(const Uart_t Uart)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_UPDATE_ID, UART_E_PARAM);
+      return;
+    }
+#endif
+
+  UART_TRACE_ENTER(Start);
+  Uart_ReceiveChannel(Uart, &UartChannels[UART_CHANNEL(Uart)]);
+  UART_TRACE_EXIT(Uart, UART_TRACE_RECEIVE_UPDATE, Start);
+}
+
+/******************************************************************************
+* Function : Uart_ServiceAll()
+*//**
+* \b Description:
+* This function is used to service all the UART channels from a single
+* scheduler task instead of calling Uart_SendUpdate and Uart_ReceiveUpdate
+* for every channel. The channels are walked round-robin, a channel with
+* nothing to send and nothing received is skipped after checking its pending
+* bit and its receive flag, and at most UART_SERVICE_BUDGET active channels
+* are serviced per call. <br>
+* PRE-CONDITION: Uart_Init called properly <br>
+* POST-CONDITION: Up to UART_SERVICE_BUDGET active channels have sent and
+* received their next byte <br>
+* @return void
+*
+* \b Example:
+* @code
+* // called every tick by the scheduler
+* Uart_ServiceAll();
+* @endcode
+* @see Uart_SendUpdate
+* @see Uart_ReceiveUpdate
+*******************************************************************************/
+extern void
+Uart_ServiceAll(void)
+{
+  Uart_t Uart = UartServiceNext;
+  uint8_t Budget = UART_SERVICE_BUDGET;
+
+  for(uint8_t i = 0; i < UART_MAX && Budget != 0; i++)
+    {
+      UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+      uint8_t Send = UartSendPending & (1 << UART_CHANNEL(Uart));
+      uint8_t Receive = UART_STATUS_REG(Channel) & (1 << RXC);
+
+      //a measured baudrate or an autobaud error waits for the receive update
+      if(Channel->Autobaud == UART_AUTOBAUD_LOCKED || Channel->AutobaudError != 0)
+        Receive = 1;
+
+#if (UART_FRAME_MODE == 1)
+      //a partly filled frame waits for the idle ticks
+      if(UartFrameChannels[UART_CHANNEL(Uart)].RxFrame != FRAME_NONE) Receive = 1;
+#endif
+#if (UART_PINGPONG_MODE == 1)
+      //a partly filled buffer waits for the idle ticks
+      if(UartPingPongs[UART_CHANNEL(Uart)].Length[UartPingPongs[UART_CHANNEL(Uart)].Fill] != 0)
+        Receive = 1;
+#endif
+
+      if(Send != 0 || Receive != 0)
+        {
+          if(Send != 0)
+            {
+              UART_TRACE_ENTER(Start);
+              Uart_SendChannel(Uart, Channel);
+              UART_TRACE_EXIT(Uart, UART_TRACE_SEND_UPDATE, Start);
+            }
+          if(Receive != 0)
+            {
+              UART_TRACE_ENTER(Start);
+              Uart_ReceiveChannel(Uart, Channel);
+              UART_TRACE_EXIT(Uart, UART_TRACE_RECEIVE_UPDATE, Start);
+            }
+          Budget--;
+        }
+
+      Uart = (Uart + 1 < UART_MAX) ? (Uart_t) (Uart + 1) : UART_0;
+    }
+
+  UartServiceNext = Uart;
+}
+
+/******************************************************************************
+* Function : Uart_SendByte()
+*//**
+* \b Description:
+* This function is used to store a byte in the UART send data buffers so it can 
+* be sent later when Uart_SendUpdate is called 
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id 
+* @param Data the byte to store 
+* @return uint8_t 1 if the byte is stored and 0 otherwise.
+*
+* @see Uart_Init
+* @see Uart_SendUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_SendByte(const Uart_t Uart, const uint8_t Data)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_BYTE_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  uint8_t Pos = Channel->SendBuff.Front;
+  uint8_t res = UART_ENQUEUE(&Channel->SendBuff, UART_SEND_DATA(Uart), Data);
+  UART_BYTE_TRACE_IN(Uart, UART_TRACE_TX_QUEUE, Pos, res);
+
+  if(res == 1 && Channel->Config->DataBits == UART_DATA_BITS_9)
+    {
+      Uart_BitmapWrite(UartSendBit8[UART_CHANNEL(Uart)], Pos, 0);
+    }
+
+  UartSendPending |= (uint8_t) (res << UART_CHANNEL(Uart));
+  return res;
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveByte()
+*//**
+* \b Description:
+* This function is used to receive the next byte from the UART receive data buffers.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id 
+* @param Data a pointer to store the received byte
+* @return uint8_t 1 if the byte is received and 0 otherwise.
+*
+* @see Uart_Init
+* @see Uart_ReceiveUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_ReceiveByte(const Uart_t Uart, uint8_t* const Data)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_BYTE_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  UART_BYTE_TRACE_MARK(Pos, Channel->ReceiveBuff.Rear);
+  uint8_t res = UART_DEQUEUE(&Channel->ReceiveBuff, UART_RECEIVE_DATA(Uart), Data);
+  UART_BYTE_TRACE_OUT(Uart, UART_TRACE_RX_QUEUE, Pos, res);
+  Uart_ReceiveResume(Uart, Channel);
+  return res;
+}
+
+/******************************************************************************
+* Function : Uart_SendString()
+*//**
+* \b Description:
+* This function is used to store a string in the UART send data buffers so it can 
+* be sent later when Uart_SendUpdate is called 
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id 
+* @param Data a pointer to the data to store in send data buffers
+* @param DataSize The size of the string to send
+* @return uint8_t the number of stored data in bytes
+*
+* @see Uart_Init
+* @see Uart_SendUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_SendString(
+  const Uart_t Uart,
+  const uint8_t * const Data,
+  const uint8_t DataSize)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_STRING_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  if(DataSize == 0) return 0;
+  
+  UART_TRACE_ENTER(Start);
+  UART_BYTE_TRACE_MARK(First, Channel->SendBuff.Front);
+  uint8_t Pos = Channel->SendBuff.Front;
+  uint8_t i = CircBuff_EnqueueBulkSized(&Channel->SendBuff, UART_SEND_DATA(Uart),
+    UART_BUFF_SIZE, Data, DataSize);
+
+  if(Channel->Config->DataBits == UART_DATA_BITS_9)
+    {
+      for(uint8_t j = 0; j < i; j++)
+        {
+          Uart_BitmapWrite(UartSendBit8[UART_CHANNEL(Uart)], Pos, 0);
+          Pos = CircBuff_Next(Pos, UART_BUFF_SIZE);
+        }
+    }
+
+  if(i != 0)
+    {
+      UartSendPending |= (uint8_t) (1 << UART_CHANNEL(Uart));
+    }
+
+  UART_BYTE_TRACE_IN(Uart, UART_TRACE_TX_QUEUE, First, i);
+  UART_TRACE_EXIT(Uart, UART_TRACE_SEND_STRING, Start);
+  return i;
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveByte()
+*//**
+* \b Description:
+* This function is used to receive a string from the UART receive data buffers.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id 
+* @param Data a pointer to store the received string in
+* @param DataSize The size of the string to receive
+* @return uint8_t the number of received data in bytes
+*
+* @see Uart_Init
+* @see Uart_ReceiveUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_ReceiveString(
+  const Uart_t Uart, 
+  uint8_t * const Data,
+  const uint8_t DataSize)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_STRING_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  if(DataSize == 0) return 0;
+
+  UART_TRACE_ENTER(Start);
+  UART_BYTE_TRACE_MARK(First, Channel->ReceiveBuff.Rear);
+  uint8_t i = CircBuff_DequeueBulkSized(&Channel->ReceiveBuff,
+    UART_RECEIVE_DATA(Uart), UART_BUFF_SIZE, Data, DataSize);
+
+  UART_BYTE_TRACE_OUT(Uart, UART_TRACE_RX_QUEUE, First, i);
+  Uart_ReceiveResume(Uart, Channel);
+
+  UART_TRACE_EXIT(Uart, UART_TRACE_RECEIVE_STRING, Start);
+  return i;
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveByteMarked()
+*//**
+* \b Description:
+* This function is used to receive the next byte from the UART receive data
+* buffers with its error mark, so a protocol layer can discard just the frame
+* the byte belongs to.
+* PRE-CONDITION: Uart_Init called properly <br>
+* PRE-CONDITION: The channel is configured with UART_RX_ERROR_MARK <br>
+* @param Uart the Uart Id 
+* @param Data a pointer to store the received byte
+* @param Error a pointer to store 1 if the byte was received with a frame,
+* overrun or parity error and 0 otherwise
+* @return uint8_t 1 if the byte is received and 0 otherwise.
+*
+* @see Uart_Init
+* @see Uart_ReceiveUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_ReceiveByteMarked(const Uart_t Uart, uint8_t* const Data, uint8_t* const Error)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Error != 0x00 && Uart < UART_MAX &&
+       UartChannels[UART_CHANNEL(Uart)].Config->RxErrorMode == UART_RX_ERROR_MARK))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_BYTE_MARKED_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  uint8_t Pos = Channel->ReceiveBuff.Rear;
+  uint8_t res = UART_DEQUEUE(&Channel->ReceiveBuff, UART_RECEIVE_DATA(Uart), Data);
+
+  if(res == 1)
+    {
+      *Error = Uart_BitmapRead(UartReceiveError[UART_CHANNEL(Uart)], Pos);
+    }
+
+  UART_BYTE_TRACE_OUT(Uart, UART_TRACE_RX_QUEUE, Pos, res);
+  Uart_ReceiveResume(Uart, Channel);
+  return res;
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveStringMarked()
+*//**
+* \b Description:
+* This function is used to receive a string from the UART receive data buffers
+* with the error marks of its bytes. Bit i of ErrorMap (bit i % 8 of byte
+* i / 8) is set if Data[i] was received with a frame, overrun or parity error.
+* PRE-CONDITION: Uart_Init called properly <br>
+* PRE-CONDITION: The channel is configured with UART_RX_ERROR_MARK <br>
+* @param Uart the Uart Id 
+* @param Data a pointer to store the received string in
+* @param DataSize The size of the string to receive
+* @param ErrorMap a pointer to store the error marks in, (DataSize + 7) / 8
+* bytes
+* @return uint8_t the number of received data in bytes
+*
+* @see Uart_Init
+* @see Uart_ReceiveUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_ReceiveStringMarked(
+  const Uart_t Uart, 
+  uint8_t * const Data,
+  const uint8_t DataSize,
+  uint8_t * const ErrorMap)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && ErrorMap != 0x00 && Uart < UART_MAX &&
+       UartChannels[UART_CHANNEL(Uart)].Config->RxErrorMode == UART_RX_ERROR_MARK))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_STRING_MARKED_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  if(DataSize == 0) return 0;
+
+  UART_BYTE_TRACE_MARK(First, Channel->ReceiveBuff.Rear);
+  uint8_t res;
+  uint8_t i = 0;
+  
+  do{
+    uint8_t Pos = Channel->ReceiveBuff.Rear;
+    res = UART_DEQUEUE(&Channel->ReceiveBuff, UART_RECEIVE_DATA(Uart), &Data[i]);
+
+    if(res == 1)
+      {
+        Uart_BitmapWrite(ErrorMap, i,
+          Uart_BitmapRead(UartReceiveError[UART_CHANNEL(Uart)], Pos));
+        i++;
+      }
+
+  } while(res == 1 && i < DataSize);
+
+  UART_BYTE_TRACE_OUT(Uart, UART_TRACE_RX_QUEUE, First, i);
+  Uart_ReceiveResume(Uart, Channel);
+
+  return i;
+}
+
+/******************************************************************************
+* Function : Uart_PeekLastByte()
+*//**
+* \b Description:
+* This function is used to peak the last received byte from the UART 
+* receive data buffers.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id 
+* @param Data a pointer to store the received byte
+* @return uint8_t 1 if the byte is received and 0 otherwise.
+*
+* @see Uart_Init
+*******************************************************************************/
+extern uint8_t 
+Uart_PeekLastByte(const Uart_t Uart, uint8_t* const Data)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_PEEK_LAST_BYTE_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  uint8_t res = CircBuff_PeekLastSized(&Channel->ReceiveBuff,
+    UART_RECEIVE_DATA(Uart), UART_BUFF_SIZE, Data);
+  return res;
+}
+
+/******************************************************************************
+* Function : Uart_PeekByte()
+*//**
+* \b Description:
+* This function is used to read a received byte without removing it from the
+* UART receive data buffers, e.g. the length field of a packet header. Offset
+* 0 is the next byte Uart_ReceiveByte returns.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id 
+* @param Offset the position of the byte from the oldest received one
+* @param Data a pointer to store the byte in
+* @return uint8_t 1 if the byte is stored and 0 if fewer bytes are received.
+*
+* @see Uart_PeekString
+* @see Uart_Skip
+*******************************************************************************/
+extern uint8_t
+Uart_PeekByte(const Uart_t Uart, const uint8_t Offset, uint8_t* const Data)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_PEEK_BYTE_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  return CircBuff_PeekAtSized(&UartChannels[UART_CHANNEL(Uart)].ReceiveBuff,
+    UART_RECEIVE_DATA(Uart), UART_BUFF_SIZE, Offset, Data);
+}
+
+/******************************************************************************
+* Function : Uart_PeekString()
+*//**
+* \b Description:
+* This function is used to copy received bytes without removing them from the
+* UART receive data buffers, so a protocol handler can inspect a header before
+* consuming the packet.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id 
+* @param Data a pointer to store the bytes in
+* @param Offset the position of the first byte from the oldest received one
+* @param DataSize the number of bytes to peek
+* @return uint8_t the number of peeked bytes
+*
+* \b Example:
+* @code
+* uint8_t Header[3];
+* if(Uart_PeekString(UART_0, Header, 0, 3) == 3 && Header[0] == SYNC)
+*   {
+*     uint8_t Payload[MAX_PAYLOAD];
+*     if(Uart_PeekString(UART_0, Payload, 3, Header[2]) == Header[2])
+*       {
+*         Packet_Handle(Header, Payload);
+*         Uart_Skip(UART_0, 3 + Header[2]);
+*       }
+*   }
+* @endcode
+* @see Uart_Skip
+*******************************************************************************/
+extern uint8_t
+Uart_PeekString(
+  const Uart_t Uart,
+  uint8_t * const Data,
+  const uint8_t Offset,
+  const uint8_t DataSize)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_PEEK_STRING_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  return CircBuff_PeekSpanSized(&UartChannels[UART_CHANNEL(Uart)].ReceiveBuff,
+    UART_RECEIVE_DATA(Uart), UART_BUFF_SIZE, Data, Offset, DataSize);
+}
+
+/******************************************************************************
+* Function : Uart_FindByte()
+*//**
+* \b Description:
+* This function is used to search the UART receive data buffers for a byte,
+* e.g. a line end or a frame delimiter, without removing anything.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id 
+* @param Data the byte to search for
+* @param Offset the position to start the search at from the oldest received
+* byte
+* @return uint8_t the position of the first match from the oldest received
+* byte, CIRCBUFF_NOT_FOUND if the byte is not received yet
+*
+* \b Example:
+* @code
+* uint8_t End = Uart_FindByte(UART_0, '\r', 0);
+* if(End != CIRCBUFF_NOT_FOUND)
+*   {
+*     Uart_ReceiveString(UART_0, Line, End);
+*     Uart_Skip(UART_0, 1);
+*   }
+* @endcode
+* @see Uart_Skip
+*******************************************************************************/
+extern uint8_t
+Uart_FindByte(const Uart_t Uart, const uint8_t Data, const uint8_t Offset)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_FIND_BYTE_ID, UART_E_PARAM);
+      return CIRCBUFF_NOT_FOUND;
+    }
+#endif
+
+  return CircBuff_FindSized(&UartChannels[UART_CHANNEL(Uart)].ReceiveBuff,
+    UART_RECEIVE_DATA(Uart), UART_BUFF_SIZE, Data, Offset);
+}
+
+/******************************************************************************
+* Function : Uart_Skip()
+*//**
+* \b Description:
+* This function is used to discard the oldest received bytes from the UART
+* receive data buffers, e.g. a packet already read with Uart_PeekString or
+* the noise before a sync byte. Their 9th bits and error marks are discarded
+* with them.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id 
+* @param Count the number of bytes to discard
+* @return uint8_t the number of discarded bytes
+*
+* @see Uart_PeekString
+* @see Uart_FindByte
+*******************************************************************************/
+extern uint8_t
+Uart_Skip(const Uart_t Uart, const uint8_t Count)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SKIP_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  UART_BYTE_TRACE_MARK(First, Channel->ReceiveBuff.Rear);
+  uint8_t res = CircBuff_SkipSized(&Channel->ReceiveBuff, UART_BUFF_SIZE, Count);
+
+  UART_BYTE_TRACE_OUT(Uart, UART_TRACE_RX_QUEUE, First, res);
+  Uart_ReceiveResume(Uart, Channel);
+
+  return res;
+}
+
+/******************************************************************************
+* Function : Uart_SendByte9()
+*//**
+* \b Description:
+* This function is used to store a 9-bit data in the UART send data buffers so
+* it can be sent later when Uart_SendUpdate is called. The 9th bit is kept in a
+* side bitmap next to the buffer.
+* PRE-CONDITION: Uart_Init called properly <br>
+* PRE-CONDITION: The channel is configured with UART_DATA_BITS_9 <br>
+* @param Uart the Uart Id 
+* @param Data the data to store, bits 0 to 8
+* @return uint8_t 1 if the data is stored and 0 otherwise.
+*
+* @see Uart_Init
+* @see Uart_SendUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_SendByte9(const Uart_t Uart, const uint16_t Data)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX &&
+       UartChannels[UART_CHANNEL(Uart)].Config->DataBits == UART_DATA_BITS_9))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_BYTE9_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  uint8_t Pos = Channel->SendBuff.Front;
+  uint8_t res = UART_ENQUEUE(&Channel->SendBuff, UART_SEND_DATA(Uart), (uint8_t) Data);
+
+  if(res == 1)
+    {
+      Uart_BitmapWrite(UartSendBit8[UART_CHANNEL(Uart)], Pos, (Data >> 8) & 0x01);
+    }
+
+  UART_BYTE_TRACE_IN(Uart, UART_TRACE_TX_QUEUE, Pos, res);
+  UartSendPending |= (uint8_t) (res << UART_CHANNEL(Uart));
+  return res;
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveByte9()
+*//**
+* \b Description:
+* This function is used to receive the next 9-bit data from the UART receive
+* data buffers.
+* PRE-CONDITION: Uart_Init called properly <br>
+* PRE-CONDITION: The channel is configured with UART_DATA_BITS_9 <br>
+* @param Uart the Uart Id 
+* @param Data a pointer to store the received data, bits 0 to 8
+* @return uint8_t 1 if the data is received and 0 otherwise.
+*
+* @see Uart_Init
+* @see Uart_ReceiveUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_ReceiveByte9(const Uart_t Uart, uint16_t* const Data)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX &&
+       UartChannels[UART_CHANNEL(Uart)].Config->DataBits == UART_DATA_BITS_9))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_BYTE9_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  uint8_t Byte;
+  uint8_t Pos = Channel->ReceiveBuff.Rear;
+  uint8_t res = UART_DEQUEUE(&Channel->ReceiveBuff, UART_RECEIVE_DATA(Uart), &Byte);
+
+  if(res == 1)
+    {
+      *Data = (uint16_t) Byte |
+        (uint16_t) Uart_BitmapRead(UartReceiveBit8[UART_CHANNEL(Uart)], Pos) << 8;
+    }
+
+  UART_BYTE_TRACE_OUT(Uart, UART_TRACE_RX_QUEUE, Pos, res);
+  Uart_ReceiveResume(Uart, Channel);
+  return res;
+}
+
+/******************************************************************************
+* Function : Uart_GetReceiveLost()
+*//**
+* \b Description:
+* This function is used to get the number of received bytes that were
+* overwritten (CIRCBUFF_OVERWRITE_OLDEST) or discarded (CIRCBUFF_REPORT)
+* because the UART receive data buffer was full.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id 
+* @return uint16_t the number of lost bytes since Uart_Init
+*
+* @see Uart_Init
+*******************************************************************************/
+extern uint16_t
+Uart_GetReceiveLost(const Uart_t Uart)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_GET_RECEIVE_LOST_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  return Channel->ReceiveBuff.Lost;
+}
+
+/******************************************************************************
+* Function : Uart_SendAddress()
+*//**
+* \b Description:
+* This function is used to address a node on a multi-processor communication
+* bus. The address frame is sent by Uart_SendUpdate right after the data
+* already stored in the UART send data buffers, and the data stored after this
+* call goes to the addressed node. Only one address can wait to be sent.
+* PRE-CONDITION: Uart_Init called properly <br>
+* PRE-CONDITION: The channel is configured with UART_MPCM_ON <br>
+* @param Uart the Uart Id 
+* @param Address the address of the node to talk to
+* @return uint8_t 1 if the address is stored and 0 otherwise.
+*
+* \b Example:
+* @code
+* Uart_SendAddress(UART_0, 0x12);
+* Uart_SendString(UART_0, Frame, FrameSize); //received by node 0x12 only
+* @endcode
+* @see Uart_Init
+* @see Uart_SendUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_SendAddress(const Uart_t Uart, const uint8_t Address)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX &&
+       UartChannels[UART_CHANNEL(Uart)].Config->Mpcm == UART_MPCM_ON))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_ADDRESS_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
 
-/**
- * brief the UART receive buffers structures
- */
-static CircBuff_t UartReceiveBuff[UART_MAX];
+  if(Channel->Flags & UART_FLAG_SEND_ADDRESS) return 0;
 
-/**
- * brief the UART data registers
- */
-static volatile uint8_t* const UartDataRegs[UART_MAX] =
-{
-  //TODO: change uint8_t according to register size
-  (volatile uint8_t*) UDR
-};
+  Channel->SendAddress = Address;
+  Channel->SendAddressPos = Channel->SendBuff.Front;
+  Channel->Flags |= UART_FLAG_SEND_ADDRESS;
+  UartSendPending |= (uint8_t) (1 << UART_CHANNEL(Uart));
+
+  return 1;
+}
 
 /******************************************************************************
- * Function Definitions
- ******************************************************************************/
-/******************************************************************************
-* Function : Uart_Init()
+* Function : Uart_Reconfigure()
 *//**
 * \b Description:
-* This function is used to initialize the Uart based on the configuration
-* table defined in uart_cfg file. <br>
-* PRE-CONDITION: Configuration table needs to populated (sizeof > 0) <br>
-* PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
-* PRE-CONDITION: The UART DIO pins are configured properly. <br>
-* POST-CONDITION: The Uart peripherals are set up with the configuration 
-* settings.<br>
-* @param Config is a pointer to the configuration table that
-* contains the initialization for the peripheral.
-* @return void
+* This function is used to change the line settings (baudrate, data bits,
+* parity, stop bits, ...) of a single channel without Uart_Init. The data in
+* the UART send and receive data buffers is kept. If the channel is sending,
+* the new settings are applied by Uart_SendUpdate at the frame boundary after
+* the data already stored in the send data buffers has been sent, so a
+* "change baudrate" request queued before this call leaves at the old
+* baudrate and the data queued after it waits for the new settings. The
+* frames queued with Uart_SendFrame and not started yet are sent with the new
+* settings. A second call before the first settings are applied replaces
+* them. When the flow control or the transceiver hook changes, the pins are
+* driven as Uart_Init leaves them. <br>
+* PRE-CONDITION: Uart_Init called properly <br>
+* PRE-CONDITION: Config stays valid while the channel uses it <br>
+* @param Uart the Uart Id 
+* @param Config a pointer to the new configuration of the channel
+* @return uint8_t 1 if the settings are applied, 0 if they are applied later
+* by Uart_SendUpdate.
 *
 * \b Example:
 * @code
-* const UartConfig_t *UartConfig = Uart_ConfigGet();
-* Uart_Init(UartConfig);
+* static const UartConfig_t FastConfig =
+* { UART_0, 115200, UART_STOP_BIT_1, UART_PARTIY_NO, UART_DATA_BITS_8, ... };
+* Uart_SendString(UART_0, SwitchBaudCmd, sizeof(SwitchBaudCmd));
+* Uart_Reconfigure(UART_0, &FastConfig);
 * @endcode
-* @see Uart_ConfigGet
+* @see Uart_Init
+* @see Uart_SendUpdate
 *******************************************************************************/
-extern void 
-Uart_Init(const UartConfig_t * const Config)
+extern uint8_t
+Uart_Reconfigure(const Uart_t Uart, const UartConfig_t * const Config)
 {
-  if(!(Config != 0x00))
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Config != 0x00 && Uart < UART_MAX))
     {
-      Det_ReportError(UART_MODULE_ID, 0, UART_INIT_ID, UART_E_PARAM);
-      return;
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECONFIGURE_ID, UART_E_PARAM);
+      return 0;
     }
+#endif
 
-  for(uint8_t i = 0; i < UART_MAX; i++)
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  uint8_t Idle =
+    Channel->SendBuff.Rear == Channel->SendBuff.Front &&
+    !(Channel->Flags & (UART_FLAG_SEND_XOFF | UART_FLAG_SEND_XON |
+                        UART_FLAG_SEND_ADDRESS));
+
+#if (UART_FRAME_MODE == 1)
+  if(UartFrameChannels[UART_CHANNEL(Uart)].TxFrame != FRAME_NONE)
     {
-      UartSendBuff[i] = CircBuff_Create(UartSendData[i], UART_BUFF_SIZE);
-      UartReceiveBuff[i] = CircBuff_Create(UartReceiveData[i], UART_BUFF_SIZE);
-    
-      *UBRRL = 0;
-      *UBRRH = 0;
-      *UCSRB = 0;
-      *UCSRC = 0;
-      //baud rate
-      *UBRRL = (((SYSTEM_FREQ)/16/Config[i].Baudrate)-1) & 0xFF;
-      *UBRRH = (((SYSTEM_FREQ)/16/Config[i].Baudrate)-1) >> 8;
-      
-      //enable UART and interrupt events 8-bit mode
-      *UCSRB = 1 << TXEN | 1 << RXEN;
-      
-
-      // When the function writes to the UCSRC Register, the URSEL bit
-      // (MSB) must be set due to the sharing of I/O location by UBRRH
-      //and UCSRC.
-      *UCSRC = 1 << UCSZ0 | 1 << UCSZ1 | 1 << URSEL;
-
-      if(Config[i].StopBit == UART_STOP_BIT_2)
-        {
-          *UCSRC |= 1 << USBS;
-        }
+      Idle = 0;
+    }
+#endif
 
-      if(Config[i].Parity == UART_PARTIY_EVEN)
-        {
-          *UCSRC |= 1 << UPM1;
-        }
-      else if(Config[i].Parity == UART_PARTIY_ODD)
-        {
-          *UCSRC |= 1 << UPM1 | 1 << UPM0;
-        }
+  if(Idle == 0 || Uart_TransmitDone(Channel) == 0)
+    {
+      Channel->PendingConfig = Config;
+      Channel->PendingConfigPos = Channel->SendBuff.Front;
+      UartSendPending |= (uint8_t) (1 << UART_CHANNEL(Uart));
+      return 0;
     }
+
+  Channel->PendingConfig = 0x00;
+  Uart_SwitchConfig(Channel, Config);
+
+  return 1;
 }
 
 /******************************************************************************
-* Function : Uart_SendUpdate()
+* Function : Uart_AutobaudStart()
 *//**
 * \b Description:
-* This function is used to send the next byte (if existed) in the UART send 
-* data buffers. <br>
+* This function is used to start measuring the baudrate of the peer. The peer
+* is expected to send SyncChar (e.g. 0x55 or 0x7F), the timestamps of the
+* edges on the receive line are passed to Uart_AutobaudCapture, and the
+* channel is locked to the closest baudrate after the last edge of SyncChar.
+* The bytes received meanwhile are discarded. <br>
 * PRE-CONDITION: Uart_Init called properly <br>
-* POST-CONDITION: The next byte (if existed) in the UART data buffers is sent <br>
 * @param Uart the Uart Id 
+* @param SyncChar the character the peer sends to be measured
 * @return void
 *
-* @see Uart_Init
+* @see Uart_AutobaudCapture
 *******************************************************************************/
 extern void
-Uart_SendUpdate(const Uart_t Uart)
+Uart_AutobaudStart(const Uart_t Uart, const uint8_t SyncChar)
 {
+#if (UART_DEV_ERROR_DETECT == 1)
   if(!(Uart < UART_MAX))
     {
-      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_UPDATE_ID, UART_E_PARAM);
+      Det_ReportError(UART_MODULE_ID, Uart, UART_AUTOBAUD_START_ID, UART_E_PARAM);
       return;
     }
+#endif
 
-  uint8_t Result;
-  uint8_t Data;
-  
-  Result = CircBuff_Dequeue(&UartSendBuff[Uart], &Data);
-  if(Result == 1)
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  //the frame is the start bit, the data bits LSB first and the stop bit,
+  //the line is idle (1) before the start bit so the first edge is at bit 0
+  uint16_t Frame = (uint16_t) (1 << 9 | SyncChar << 1);
+  uint8_t Level = 1;
+  uint8_t Expected = 0;
+  uint8_t LastPos = 0;
+
+  for(uint8_t Pos = 0; Pos < 10; Pos++)
     {
-      //Transmit buffer empty ?
-      if(*UCSRA & (1<<UDRE))
-        {
-          *UartDataRegs[Uart] = Data;
-        }
-      else
+      uint8_t Bit = (Frame >> Pos) & 0x01;
+
+      if(Bit != Level)
         {
-          Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_UPDATE_ID, UART_E_TB_NEMPTY);
+          Expected++;
+          LastPos = Pos;
+          Level = Bit;
         }
     }
 
+  //the capture interrupt ignores the channel until the measurement is set up
+  Channel->Autobaud = UART_AUTOBAUD_IDLE;
+  Channel->AutobaudExpected = Expected;
+  Channel->AutobaudLastPos = LastPos;
+  Channel->AutobaudEdges = 0;
+  Channel->Autobaud = UART_AUTOBAUD_MEASURE;
 }
 
 /******************************************************************************
-* Function : Uart_ReceiveUpdate()
+* Function : Uart_AutobaudCapture()
 *//**
 * \b Description:
-* This function is used to receive a byte (if existed) in the UART receive 
-* data registers and store them in the UART receive buffers. <br>
-* PRE-CONDITION: Uart_Init called properly <br>
-* POST-CONDITION: The next byte (if existed) in the UART data registers is 
-* received <br>
+* This function is used to pass the timestamp of an edge on the receive line
+* while the baudrate is measured. It's called by the capture facility of the
+* target (e.g. the timer input capture interrupt with RXD routed to ICP1) or
+* by the host simulator. When the last edge of the sync character is captured
+* the bit time is computed, the closest UBRR in the normal or the double speed
+* (U2X) mode is selected and the channel is locked. It's safe to call from an
+* interrupt: it doesn't call Det and doesn't write the Uart registers, the
+* measured baudrate is applied and a baudrate out of range is reported by the
+* next Uart_ReceiveUpdate (or Uart_ServiceAll). <br>
+* PRE-CONDITION: Uart_AutobaudStart called <br>
+* PRE-CONDITION: The timer runs at SYSTEM_FREQ / UART_AUTOBAUD_PRESCALER <br>
 * @param Uart the Uart Id 
-* @return void
+* @param Timestamp the timer value at the edge
+* @return uint8_t 1 if the channel is locked to the measured baudrate, 0
+* otherwise. The bytes received until the next receive update are discarded.
 *
-* @see Uart_Init
+* \b Example:
+* @code
+* ISR(TIMER1_CAPT_vect)
+* {
+*   TCCR1B ^= 1 << ICES1; //capture the next edge of the other direction
+*   Uart_AutobaudCapture(UART_0, ICR1);
+* }
+* @endcode
+* @see Uart_AutobaudStart
 *******************************************************************************/
-extern void
-Uart_ReceiveUpdate(const Uart_t Uart)
+extern uint8_t
+Uart_AutobaudCapture(const Uart_t Uart, const uint16_t Timestamp)
 {
-  if(!(Uart < UART_MAX))
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX)) return 0;
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[UART_CHANNEL(Uart)];
+
+  if(Channel->Autobaud != UART_AUTOBAUD_MEASURE) return 0;
+
+  if(Channel->AutobaudEdges == 0)
     {
-      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_UPDATE_ID, UART_E_PARAM);
-      return;
+      Channel->AutobaudFirst = Timestamp;
     }
 
-  uint8_t Result;
-  uint8_t Data;
-  uint8_t error = 0;
+  Channel->AutobaudEdges++;
+  if(Channel->AutobaudEdges < Channel->AutobaudExpected) return 0;
 
-  //received something ?
-  if(*UCSRA & (1 << RXC))
-    {
-      //error bits are valid until the receive buffer (UDR) is read
-      if(*UCSRA & (1 << FE))
-        {
-          Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_FRAME);
-          error = 1;
-        }
+  //the system clocks per bit, rounded
+  uint32_t Span = (uint16_t) (Timestamp - Channel->AutobaudFirst);
+  uint8_t LastPos = Channel->AutobaudLastPos;
+  uint32_t Clocks = (Span * UART_AUTOBAUD_PRESCALER + LastPos / 2) / LastPos;
 
-      if(*UCSRA & (1 << DOR))
-        {
-          Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_OVERRUN);
-          error = 1;              
-        }
+  //the normal mode divides by 16 and the double speed mode by 8
+  uint32_t Normal = (Clocks + 8) / 16;
+  uint32_t Double = (Clocks + 4) / 8;
+  uint32_t NormalError = (Normal * 16 > Clocks) ?
+    (Normal * 16 - Clocks) : (Clocks - Normal * 16);
+  uint32_t DoubleError = (Double * 8 > Clocks) ?
+    (Double * 8 - Clocks) : (Clocks - Double * 8);
 
-      if(*UCSRA & (1 << PE))
-        {
-          Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_PARITY);
-          error = 1;
-        }
+  Channel->AutobaudEdges = 0;
 
-      if(error == 0)
-        {
-          Data = *UartDataRegs[Uart];
-          Result = CircBuff_Enqueue(&UartReceiveBuff[Uart], Data);
-        }
-      else
-        {
-          //clear RXC flag
-          Data = *UartDataRegs[Uart];
-        }
+  if(Normal >= 1 && Normal - 1 <= UART_UBRR_MAX &&
+     (NormalError <= DoubleError || Double - 1 > UART_UBRR_MAX))
+    {
+      Channel->AutobaudUbrr = (uint16_t) (Normal - 1);
+      Channel->AutobaudDoubleSpeed = 0;
+    }
+  else if(Double >= 1 && Double - 1 <= UART_UBRR_MAX)
+    {
+      Channel->AutobaudUbrr = (uint16_t) (Double - 1);
+      Channel->AutobaudDoubleSpeed = 1;
+    }
+  else
+    {
+      //keep measuring, the next sync character may be cleaner
+      Channel->AutobaudError = 1;
+      return 0;
     }
+
+  Channel->Autobaud = UART_AUTOBAUD_LOCKED;
+  return 1;
 }
 
+#if (UART_FRAME_MODE == 1)
 /******************************************************************************
-* Function : Uart_SendByte()
+* Function : Uart_AllocFrame()
 *//**
 * \b Description:
-* This function is used to store a byte in the UART send data buffers so it can 
-* be sent later when Uart_SendUpdate is called 
+* This function is used to get an empty frame to fill and send. The frame is
+* written in place, so a packet is never copied into the send buffer. <br>
 * PRE-CONDITION: Uart_Init called properly <br>
 * @param Uart the Uart Id 
-* @param Data the byte to store 
-* @return uint8_t 1 if the byte is stored and 0 otherwise.
+* @param Frame a pointer to store the frame in
+* @return uint8_t 1 if a frame is got, 0 if all the send frames are in use
 *
-* @see Uart_Init
+* \b Example:
+* @code
+* UartFrame_t Frame;
+* if(Uart_AllocFrame(UART_0, &Frame) == 1)
+*   {
+*     Frame.Length = Packet_Build(Frame.Data);
+*     Uart_SendFrame(UART_0, &Frame);
+*   }
+* @endcode
+* @see Uart_SendFrame
+*******************************************************************************/
+extern uint8_t
+Uart_AllocFrame(const Uart_t Uart, UartFrame_t* const Frame)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Frame != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_ALLOC_FRAME_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartFrameChannel_t * const Frames = &UartFrameChannels[UART_CHANNEL(Uart)];
+
+  Frame->Handle = FramePool_Alloc(&Frames->TxPool);
+  if(Frame->Handle == FRAME_NONE) return 0;
+
+  Frames->TxQueued &= (uint8_t) ~(1 << Frame->Handle);
+  Frame->Data = FramePool_Data(&Frames->TxPool, Frame->Handle);
+  Frame->Length = 0;
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : Uart_SendFrame()
+*//**
+* \b Description:
+* This function is used to queue a frame got by Uart_AllocFrame for sending.
+* The frames are sent in order after the bytes of the send buffer, and every
+* frame is given back to the driver after its last byte, the application must
+* not use it after this call. A frame that is not allocated or already queued
+* is rejected. <br>
+* PRE-CONDITION: Uart_Init called properly <br>
+* PRE-CONDITION: The channel is configured with 5 to 8 data bits <br>
+* @param Uart the Uart Id 
+* @param Frame a pointer to the frame, Length at most UART_FRAME_SIZE
+* @return uint8_t 1 if the frame is queued, 0 otherwise
+*
+* @see Uart_AllocFrame
 * @see Uart_SendUpdate
 *******************************************************************************/
 extern uint8_t
-Uart_SendByte(const Uart_t Uart, const uint8_t Data)
+Uart_SendFrame(const Uart_t Uart, const UartFrame_t* const Frame)
 {
-  if(!(Uart < UART_MAX))
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Frame != 0x00 && Uart < UART_MAX && Frame->Handle < UART_FRAME_COUNT &&
+       Frame->Length <= UART_FRAME_SIZE &&
+       UartChannels[UART_CHANNEL(Uart)].Config->DataBits != UART_DATA_BITS_9))
     {
-      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_BYTE_ID, UART_E_PARAM);
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_FRAME_ID, UART_E_PARAM);
       return 0;
     }
+#endif
 
-  uint8_t res = CircBuff_Enqueue(&UartSendBuff[Uart], Data);
-  return res;
+  UartFrameChannel_t * const Frames = &UartFrameChannels[UART_CHANNEL(Uart)];
+
+  if(FramePool_IsAllocated(&Frames->TxPool, Frame->Handle) == 0 ||
+     (Frames->TxQueued & (1 << Frame->Handle)))
+    {
+#if (UART_DEV_ERROR_DETECT == 1)
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_FRAME_ID, UART_E_PARAM);
+#endif
+      return 0;
+    }
+
+  Frames->TxQueued |= (uint8_t) (1 << Frame->Handle);
+  FramePool_SetLength(&Frames->TxPool, Frame->Handle, Frame->Length);
+  FrameRing_Enqueue(&Frames->TxQueue, Frame->Handle);
+  UartSendPending |= (uint8_t) (1 << UART_CHANNEL(Uart));
+
+  return 1;
 }
 
 /******************************************************************************
-* Function : Uart_ReceiveByte()
+* Function : Uart_ReceiveFrame()
 *//**
 * \b Description:
-* This function is used to receive the next byte from the UART receive data buffers.
+* This function is used to get the oldest received frame. A frame ends with
+* the FrameEnd byte of the channel, when it's full, or when the line was idle
+* for FrameIdleTicks receive updates. The frame is lent to the application
+* until Uart_ReleaseFrame. <br>
 * PRE-CONDITION: Uart_Init called properly <br>
+* PRE-CONDITION: The channel is configured with UART_RX_MODE_FRAME <br>
 * @param Uart the Uart Id 
-* @param Data a pointer to store the received byte
-* @return uint8_t 1 if the byte is received and 0 otherwise.
+* @param Frame a pointer to store the frame in
+* @return uint8_t 1 if a frame is received, 0 otherwise
 *
-* @see Uart_Init
+* \b Example:
+* @code
+* UartFrame_t Frame;
+* while(Uart_ReceiveFrame(UART_0, &Frame) == 1)
+*   {
+*     Packet_Parse(Frame.Data, Frame.Length);
+*     Uart_ReleaseFrame(UART_0, &Frame);
+*   }
+* @endcode
+* @see Uart_ReleaseFrame
 * @see Uart_ReceiveUpdate
 *******************************************************************************/
 extern uint8_t
-Uart_ReceiveByte(const Uart_t Uart, uint8_t* const Data)
+Uart_ReceiveFrame(const Uart_t Uart, UartFrame_t* const Frame)
 {
-  if(!(Data != 0x00 && Uart < UART_MAX))
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Frame != 0x00 && Uart < UART_MAX))
     {
-      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_BYTE_ID, UART_E_PARAM);
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_FRAME_ID, UART_E_PARAM);
       return 0;
     }
+#endif
 
-  uint8_t res = CircBuff_Dequeue(&UartReceiveBuff[Uart], Data);
-  return res;
+  UartFrameChannel_t * const Frames = &UartFrameChannels[UART_CHANNEL(Uart)];
+
+  if(FrameRing_Dequeue(&Frames->RxReady, &Frame->Handle) == 0)
+    {
+      Frame->Handle = FRAME_NONE;
+      return 0;
+    }
+
+  Frames->RxHeld |= (uint8_t) (1 << Frame->Handle);
+  Frame->Data = FramePool_Data(&Frames->RxPool, Frame->Handle);
+  Frame->Length = FramePool_GetLength(&Frames->RxPool, Frame->Handle);
+
+  return 1;
 }
 
 /******************************************************************************
-* Function : Uart_SendString()
+* Function : Uart_ReleaseFrame()
 *//**
 * \b Description:
-* This function is used to store a string in the UART send data buffers so it can 
-* be sent later when Uart_SendUpdate is called 
+* This function is used to give a frame got by Uart_ReceiveFrame back to the
+* driver to be filled again, a frame that is not held by the application
+* (e.g. released twice) is rejected. The peer is allowed to send again once
+* the frames in use dropped to UART_FRAME_LOW_WATERMARK. <br>
 * PRE-CONDITION: Uart_Init called properly <br>
 * @param Uart the Uart Id 
-* @param Data a pointer to the data to store in send data buffers
-* @param DataSize The size of the string to send
-* @return uint8_t the number of stored data in bytes
+* @param Frame a pointer to the frame
+* @return uint8_t 1 if the frame is released, 0 otherwise
 *
-* @see Uart_Init
-* @see Uart_SendUpdate
+* @see Uart_ReceiveFrame
 *******************************************************************************/
 extern uint8_t
-Uart_SendString(
-  const Uart_t Uart,
-  const uint8_t * const Data,
-  const uint8_t DataSize)
+Uart_ReleaseFrame(const Uart_t Uart, const UartFrame_t* const Frame)
 {
-  if(!(Data != 0x00 && Uart < UART_MAX))
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Frame != 0x00 && Uart < UART_MAX && Frame->Handle < UART_FRAME_COUNT))
     {
-      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_STRING_ID, UART_E_PARAM);
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RELEASE_FRAME_ID, UART_E_PARAM);
       return 0;
     }
+#endif
 
-  if(DataSize == 0) return 0;
-  
-  uint8_t res;
-  uint8_t i = 0;
+  UartFrameChannel_t * const Frames = &UartFrameChannels[UART_CHANNEL(Uart)];
 
-  do{
-    res = CircBuff_Enqueue(&UartSendBuff[Uart], Data[i]);
+  if(!(Frame->Handle < UART_FRAME_COUNT && (Frames->RxHeld & (1 << Frame->Handle))))
+    {
+#if (UART_DEV_ERROR_DETECT == 1)
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RELEASE_FRAME_ID, UART_E_PARAM);
+#endif
+      return 0;
+    }
 
-    i = (res == 1) ? (i + 1) : i;
+  Frames->RxHeld &= (uint8_t) ~(1 << Frame->Handle);
+  FramePool_Free(&Frames->RxPool, Frame->Handle);
 
-  } while(res == 1 && i < DataSize);
+  if(UART_FRAME_COUNT - FramePool_GetFree(&Frames->RxPool) <= UART_FRAME_LOW_WATERMARK)
+    {
+      Uart_ReceiveFlow(Uart, &UartChannels[UART_CHANNEL(Uart)], 0);
+    }
 
-  return i;
+  return 1;
 }
+#endif
 
+#if (UART_PINGPONG_MODE == 1)
 /******************************************************************************
-* Function : Uart_ReceiveByte()
+* Function : Uart_ReceiveBurst()
 *//**
 * \b Description:
-* This function is used to receive a string from the UART receive data buffers.
+* This function is used to get the oldest received burst, a linear buffer
+* the parser can run over without wrap checks. A burst ends when its buffer
+* is full or when the line was idle for FrameIdleTicks receive updates. The
+* buffer is lent to the application until Uart_ReleaseBurst, meanwhile the
+* receive path fills the other buffer. The same burst is returned until it's
+* released. <br>
 * PRE-CONDITION: Uart_Init called properly <br>
+* PRE-CONDITION: The channel is configured with UART_RX_MODE_PINGPONG <br>
 * @param Uart the Uart Id 
-* @param Data a pointer to store the received string in
-* @param DataSize The size of the string to receive
-* @return uint8_t the number of received data in bytes
+* @param Data a pointer to store the address of the burst in
+* @return uint8_t the number of bytes in the burst, 0 if no burst is received
 *
-* @see Uart_Init
+* \b Example:
+* @code
+* const uint8_t* Burst;
+* uint8_t Length = Uart_ReceiveBurst(UART_0, &Burst);
+* if(Length != 0)
+*   {
+*     Decoder_Run(Burst, Length);
+*     Uart_ReleaseBurst(UART_0);
+*   }
+* @endcode
+* @see Uart_ReleaseBurst
 * @see Uart_ReceiveUpdate
 *******************************************************************************/
 extern uint8_t
-Uart_ReceiveString(
-  const Uart_t Uart, 
-  uint8_t * const Data,
-  const uint8_t DataSize)
+Uart_ReceiveBurst(const Uart_t Uart, const uint8_t ** const Data)
 {
+#if (UART_DEV_ERROR_DETECT == 1)
   if(!(Data != 0x00 && Uart < UART_MAX))
     {
-      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_STRING_ID, UART_E_PARAM);
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_BURST_ID, UART_E_PARAM);
       return 0;
     }
+#endif
 
-  if(DataSize == 0) return 0;
-
-  uint8_t res;
-  uint8_t i = 0;
-  
-  do{
-    res = CircBuff_Dequeue(&UartReceiveBuff[Uart], &Data[i]);
+  UartPingPong_t * const PingPong = &UartPingPongs[UART_CHANNEL(Uart)];
+  uint8_t Ready = CIRCBUFF_LOAD_ACQUIRE(PingPong->Ready);
 
-    i = (res == 1) ? (i + 1) : i;
-
-  } while(res == 1 && i < DataSize);
+  if(Ready == UART_PINGPONG_NONE) return 0;
 
-  return i;
+  *Data = PingPong->Buff[Ready];
+  return PingPong->Length[Ready];
 }
 
 /******************************************************************************
-* Function : Uart_PeekLastByte()
+* Function : Uart_ReleaseBurst()
 *//**
 * \b Description:
-* This function is used to peak the last received byte from the UART 
-* receive data buffers.
+* This function is used to give the burst got by Uart_ReceiveBurst back to
+* the driver to be filled again, the peer is allowed to send again if it was
+* stopped. <br>
 * PRE-CONDITION: Uart_Init called properly <br>
 * @param Uart the Uart Id 
-* @param Data a pointer to store the received byte
-* @return uint8_t 1 if the byte is received and 0 otherwise.
+* @return uint8_t 1 if a burst is released, 0 if none was received
 *
-* @see Uart_Init
+* @see Uart_ReceiveBurst
 *******************************************************************************/
-extern uint8_t 
-Uart_PeekLastByte(const Uart_t Uart, uint8_t* const Data)
+extern uint8_t
+Uart_ReleaseBurst(const Uart_t Uart)
 {
-  if(!(Data != 0x00 && Uart < UART_MAX))
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
     {
-      Det_ReportError(UART_MODULE_ID, Uart, UART_PEEK_LAST_BYTE_ID, UART_E_PARAM);
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RELEASE_BURST_ID, UART_E_PARAM);
       return 0;
     }
+#endif
 
-  uint8_t res = CircBuff_PeekLast(&UartReceiveBuff[Uart], Data);
-  return res;
+  UartPingPong_t * const PingPong = &UartPingPongs[UART_CHANNEL(Uart)];
+
+  if(PingPong->Ready == UART_PINGPONG_NONE) return 0;
+
+  CIRCBUFF_STORE_RELEASE(PingPong->Ready, UART_PINGPONG_NONE);
+  Uart_ReceiveFlow(Uart, &UartChannels[UART_CHANNEL(Uart)], 0);
+  return 1;
 }
+#endif
 
 /*****************************End of File ************************************/
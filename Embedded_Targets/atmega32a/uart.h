@@ -24,7 +24,26 @@ typedef enum
   UART_RECEIVE_BYTE_ID,
   UART_SEND_STRING_ID,
   UART_RECEIVE_STRING_ID,
-  UART_PEEK_LAST_BYTE_ID
+  UART_PEEK_LAST_BYTE_ID,
+  UART_GET_RECEIVE_LOST_ID,
+  UART_SEND_ADDRESS_ID,
+  UART_SEND_BYTE9_ID,
+  UART_RECEIVE_BYTE9_ID,
+  UART_RECONFIGURE_ID,
+  UART_AUTOBAUD_START_ID,
+  UART_AUTOBAUD_CAPTURE_ID,
+  UART_RECEIVE_BYTE_MARKED_ID,
+  UART_RECEIVE_STRING_MARKED_ID,
+  UART_ALLOC_FRAME_ID,
+  UART_SEND_FRAME_ID,
+  UART_RECEIVE_FRAME_ID,
+  UART_RELEASE_FRAME_ID,
+  UART_RECEIVE_BURST_ID,
+  UART_RELEASE_BURST_ID,
+  UART_PEEK_BYTE_ID,
+  UART_PEEK_STRING_ID,
+  UART_FIND_BYTE_ID,
+  UART_SKIP_ID
 } UartServiceId_t;
 
 /**
@@ -36,7 +55,10 @@ typedef enum
   UART_E_FRAME, /**< The Uart frame is wrong */
   UART_E_OVERRUN, /**< Overrun error (wasted received value) */
   UART_E_PARITY, /**< parity error */
-  UART_E_TB_NEMPTY /**< transmit buffer not empty */
+  UART_E_TB_NEMPTY, /**< transmit buffer not empty */
+  UART_E_RX_OVERFLOW, /**< receive buffer full (CIRCBUFF_REPORT policy) */
+  UART_E_AUTOBAUD, /**< the measured baudrate is out of range */
+  UART_E_MAX /**< the number of errors, the size of the Det error table */
 } UartError_t;
 
 /******************************************************************************
@@ -44,6 +66,18 @@ typedef enum
  ******************************************************************************/
 #include <inttypes.h>
 #include "uart_cfg.h"
+/******************************************************************************
+ * typedefs
+ ******************************************************************************/
+/**
+ * @brief A frame lent by the driver to the application
+ */
+typedef struct
+{
+  FrameHandle_t Handle; /**< the frame handle, FRAME_NONE if none */
+  uint8_t* Data; /**< the frame data, UART_FRAME_SIZE bytes */
+  uint8_t Length; /**< the number of bytes in the frame */
+} UartFrame_t;
 /******************************************************************************
  * Function prototypes
  ******************************************************************************/
@@ -52,17 +86,45 @@ extern "C"{
 #endif
 
 extern void Uart_Init(const UartConfig_t * const Config);
+extern uint8_t Uart_Reconfigure(const Uart_t Uart, const UartConfig_t * const Config);
+extern void Uart_AutobaudStart(const Uart_t Uart, const uint8_t SyncChar);
+extern uint8_t Uart_AutobaudCapture(const Uart_t Uart, const uint16_t Timestamp);
 
 extern void Uart_SendUpdate(const Uart_t Uart);
 extern void Uart_ReceiveUpdate(const Uart_t Uart);
+extern void Uart_ServiceAll(void);
 
 extern uint8_t Uart_SendByte(const Uart_t Uart, const uint8_t Data);
 extern uint8_t Uart_ReceiveByte(const Uart_t Uart, uint8_t* const Data);
 extern uint8_t Uart_PeekLastByte(const Uart_t Uart, uint8_t* const Data);
+extern uint8_t Uart_PeekByte(const Uart_t Uart, const uint8_t Offset, uint8_t* const Data);
+extern uint8_t Uart_PeekString(const Uart_t Uart, uint8_t * const Data, const uint8_t Offset, const uint8_t DataSize);
+extern uint8_t Uart_FindByte(const Uart_t Uart, const uint8_t Data, const uint8_t Offset);
+extern uint8_t Uart_Skip(const Uart_t Uart, const uint8_t Count);
+extern uint8_t Uart_SendByte9(const Uart_t Uart, const uint16_t Data);
+extern uint8_t Uart_ReceiveByte9(const Uart_t Uart, uint16_t* const Data);
+extern uint16_t Uart_GetReceiveLost(const Uart_t Uart);
+
+extern uint8_t Uart_SendAddress(const Uart_t Uart, const uint8_t Address);
 
 extern uint8_t Uart_SendString(const Uart_t Uart, const uint8_t * const Data, const uint8_t DataSize);
 extern uint8_t Uart_ReceiveString(const Uart_t Uart, uint8_t * const Data, const uint8_t DataSize);
 
+extern uint8_t Uart_ReceiveByteMarked(const Uart_t Uart, uint8_t* const Data, uint8_t* const Error);
+extern uint8_t Uart_ReceiveStringMarked(const Uart_t Uart, uint8_t * const Data, const uint8_t DataSize, uint8_t * const ErrorMap);
+
+#if (UART_FRAME_MODE == 1)
+extern uint8_t Uart_AllocFrame(const Uart_t Uart, UartFrame_t* const Frame);
+extern uint8_t Uart_SendFrame(const Uart_t Uart, const UartFrame_t* const Frame);
+extern uint8_t Uart_ReceiveFrame(const Uart_t Uart, UartFrame_t* const Frame);
+extern uint8_t Uart_ReleaseFrame(const Uart_t Uart, const UartFrame_t* const Frame);
+#endif
+
+#if (UART_PINGPONG_MODE == 1)
+extern uint8_t Uart_ReceiveBurst(const Uart_t Uart, const uint8_t ** const Data);
+extern uint8_t Uart_ReleaseBurst(const Uart_t Uart);
+#endif
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
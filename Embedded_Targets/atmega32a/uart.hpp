@@ -0,0 +1,319 @@
+/**
+ * @file uart.hpp
+ * @author Mohamed Hassanin
+ * @brief A header-only C++ layer of the UART driver. The channel, the buffer
+ * sizes, the receive policy, the baudrate and the handling of the erroneous
+ * bytes are template parameters, so the
+ * index wrapping, the policy branches and the register addresses are resolved
+ * at compile time and the baudrate is checked by the compiler.
+ * Note: the frame format is fixed to 8N1, use the C driver for the other
+ * formats, flow control and the half-duplex and multi-processor modes. A
+ * channel must be driven either by this layer or by the C driver, not both.
+ * @version 0.1
+ * @date 2021-03-08
+ */
+#ifndef UART_HPP
+#define UART_HPP
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+#include "uart.h"
+#include "uart_memmap.h"
+#include "det.h"
+#include "ring_buffer.hpp"
+
+namespace uart
+{
+/******************************************************************************
+ * Baudrate
+ ******************************************************************************/
+/**
+ * @brief The compile time baudrate register calculation. The normal mode (16
+ * samples per bit) is used unless its error is above UART_BAUD_ERROR_MAX, then
+ * the double speed mode (8 samples per bit) is tried. A baudrate that can't
+ * be generated within UART_BAUD_ERROR_MAX from Freq doesn't compile.
+ *
+ * @tparam Freq the system frequency
+ * @tparam Baudrate the baudrate
+ */
+template <uint32_t Freq, uint32_t Baudrate>
+struct Baud
+{
+  /** @brief the rounded UBRR for a number of samples per bit */
+  static constexpr uint32_t UbrrFor(const uint32_t Samples)
+  {
+    return (Freq + Samples * Baudrate / 2) / (Samples * Baudrate) - 1;
+  }
+
+  /** @brief the baudrate error of UbrrFor(Samples) in per mille */
+  static constexpr uint32_t ErrorFor(const uint32_t Samples)
+  {
+    return Distance(Freq / (Samples * (UbrrFor(Samples) + 1)), Baudrate) * 1000ul /
+      Baudrate;
+  }
+
+  static constexpr uint32_t Distance(const uint32_t A, const uint32_t B)
+  {
+    return (A > B) ? (A - B) : (B - A);
+  }
+
+  static_assert(Baudrate != 0 && Freq >= 8 * Baudrate,
+    "the baudrate is too high for SYSTEM_FREQ");
+
+  static constexpr bool DoubleSpeed = ErrorFor(16) > UART_BAUD_ERROR_MAX;
+  static constexpr uint16_t Ubrr = (uint16_t) UbrrFor(DoubleSpeed ? 8 : 16);
+  static constexpr uint32_t Error = ErrorFor(DoubleSpeed ? 8 : 16);
+
+  static_assert(UbrrFor(DoubleSpeed ? 8 : 16) <= 4095,
+    "the baudrate is too low for SYSTEM_FREQ, UBRR is 12 bits");
+  static_assert(Error <= UART_BAUD_ERROR_MAX,
+    "the baudrate error is above UART_BAUD_ERROR_MAX for SYSTEM_FREQ");
+};
+
+/******************************************************************************
+ * Registers
+ ******************************************************************************/
+/**
+ * @brief The registers of a Uart peripheral, a specialisation per channel
+ * resolves them to fixed addresses.
+ */
+template <Uart_t Channel>
+struct Registers;
+
+template <>
+struct Registers<UART_0>
+{
+  static volatile uint8_t& Status() { return *UCSRA; }
+  static volatile uint8_t& Control() { return *UCSRB; }
+  static volatile uint8_t& FrameControl() { return *UCSRC; }
+  static volatile uint8_t& Data() { return *UDR; }
+  static volatile uint8_t& BaudLow() { return *UBRRL; }
+  static volatile uint8_t& BaudHigh() { return *UBRRH; }
+};
+
+/******************************************************************************
+ * Uart
+ ******************************************************************************/
+/**
+ * @brief A Uart channel. All the members are static, a channel is a single
+ * peripheral and its buffers are allocated once per instantiation.
+ *
+ * \b Example:
+ * @code
+ * typedef uart::Uart<UART_0, 32, 64, CIRCBUFF_OVERWRITE_OLDEST, 115200> Console;
+ *
+ * Console::Init();
+ * Console::SendString((const uint8_t*) "hello", 5);
+ * // called every tick by the scheduler
+ * Console::SendUpdate();
+ * Console::ReceiveUpdate();
+ * @endcode
+ *
+ * @tparam Channel the Uart Id
+ * @tparam TxSize the number of slots of the send buffer
+ * @tparam RxSize the number of slots of the receive buffer
+ * @tparam Policy what to do with a byte received into a full receive buffer
+ * @tparam Baudrate the baudrate, checked against SYSTEM_FREQ
+ * @tparam ErrorMode what to do with a byte received with a frame, overrun or
+ * parity error, UART_RX_ERROR_MARK adds ReceiveByteMarked
+ */
+template <Uart_t Channel, uint8_t TxSize = UART_BUFF_SIZE,
+  uint8_t RxSize = UART_BUFF_SIZE, CircBuffPolicy_t Policy = CIRCBUFF_DROP_NEW,
+  uint32_t Baudrate = 9600, UartRxErrorMode_t ErrorMode = UART_RX_ERROR_DISCARD>
+class Uart
+{
+  typedef Registers<Channel> Regs;
+  typedef Baud<SYSTEM_FREQ, Baudrate> BaudCfg;
+
+public:
+  /**
+   * @brief Sets up the peripheral (8N1) and empties the buffers
+   */
+  static void Init()
+  {
+    SendBuff.Reset();
+    ReceiveBuff.Reset();
+    Lost = 0;
+
+    Regs::Control() = 0;
+    Regs::BaudHigh() = (uint8_t) (BaudCfg::Ubrr >> 8);
+    Regs::BaudLow() = (uint8_t) (BaudCfg::Ubrr & 0xFF);
+    Regs::Status() = BaudCfg::DoubleSpeed ? (1 << U2X) : 0;
+    // URSEL selects UCSRC, it shares its I/O location with UBRRH
+    Regs::FrameControl() = 1 << URSEL | 1 << UCSZ1 | 1 << UCSZ0;
+    Regs::Control() = 1 << TXEN | 1 << RXEN;
+  }
+
+  /**
+   * @brief Sends the next byte (if existed) of the send buffer. The byte is
+   * dequeued only when the data register is empty so it's never lost.
+   */
+  static void SendUpdate()
+  {
+    uint8_t Data;
+
+    if((Regs::Status() & (1 << UDRE)) && SendBuff.Dequeue(Data))
+      {
+        Regs::Data() = Data;
+      }
+  }
+
+  /**
+   * @brief Stores the received byte (if existed) in the receive buffer. Each
+   * error of a byte (frame, overrun, parity) is reported, then the byte is
+   * discarded or, with UART_RX_ERROR_MARK, stored and marked.
+   */
+  static void ReceiveUpdate()
+  {
+    uint8_t Status = Regs::Status();
+
+    if(!(Status & (1 << RXC))) return;
+
+    // the error bits are valid until the data register is read
+    uint8_t Data = Regs::Data();
+    bool Error = false;
+
+    if(Status & (1 << FE))
+      {
+        Det_ReportError(UART_MODULE_ID, Channel, UART_RECEIVE_UPDATE_ID, UART_E_FRAME);
+        Error = true;
+      }
+
+    if(Status & (1 << DOR))
+      {
+        Det_ReportError(UART_MODULE_ID, Channel, UART_RECEIVE_UPDATE_ID,
+          UART_E_OVERRUN);
+        Error = true;
+      }
+
+    if(Status & (1 << PE))
+      {
+        Det_ReportError(UART_MODULE_ID, Channel, UART_RECEIVE_UPDATE_ID,
+          UART_E_PARITY);
+        Error = true;
+      }
+
+    if(Error && ErrorMode == UART_RX_ERROR_DISCARD) return;
+
+    // the mark of a free slot is published with the byte
+    if(ErrorMode == UART_RX_ERROR_MARK) Mark(ReceiveBuff.FrontSlot(), Error);
+
+    if(ReceiveBuff.Enqueue(Data)) return;
+
+    if(Policy == CIRCBUFF_OVERWRITE_OLDEST)
+      {
+        ReceiveBuff.EnqueueOverwrite(Data);
+        Lost++;
+      }
+    else if(Policy == CIRCBUFF_REPORT)
+      {
+        Lost++;
+        Det_ReportError(UART_MODULE_ID, Channel, UART_RECEIVE_UPDATE_ID,
+          UART_E_RX_OVERFLOW);
+      }
+  }
+
+  /**
+   * @brief Stores a byte in the send buffer
+   * @return true if it's stored, false if the send buffer is full
+   */
+  static bool SendByte(const uint8_t Data)
+  {
+    return SendBuff.Enqueue(Data);
+  }
+
+  /**
+   * @brief Gets the next byte of the receive buffer
+   * @return true if a byte is received, false if the receive buffer is empty
+   */
+  static bool ReceiveByte(uint8_t& Data)
+  {
+    return ReceiveBuff.Dequeue(Data);
+  }
+
+  /**
+   * @brief Gets the next byte of the receive buffer and whether it was
+   * received with an error, needs UART_RX_ERROR_MARK
+   * @return true if a byte is received, false if the receive buffer is empty
+   */
+  static bool ReceiveByteMarked(uint8_t& Data, bool& Error)
+  {
+    static_assert(ErrorMode == UART_RX_ERROR_MARK,
+      "ReceiveByteMarked needs UART_RX_ERROR_MARK");
+
+    uint8_t Pos = ReceiveBuff.RearSlot();
+
+    if(!ReceiveBuff.Dequeue(Data)) return false;
+
+    Error = (ErrorMap[Pos / 8] >> (Pos % 8)) & 0x01;
+
+    return true;
+  }
+
+  /**
+   * @brief Stores a string in the send buffer
+   * @return the number of stored bytes
+   */
+  static uint8_t SendString(const uint8_t * const Data, const uint8_t DataSize)
+  {
+    return SendBuff.EnqueueBulk(Data, DataSize);
+  }
+
+  /**
+   * @brief Gets up to DataSize bytes of the receive buffer
+   * @return the number of received bytes
+   */
+  static uint8_t ReceiveString(uint8_t * const Data, const uint8_t DataSize)
+  {
+    return ReceiveBuff.DequeueBulk(Data, DataSize);
+  }
+
+  /**
+   * @brief Gets the number of bytes lost by the receive policy
+   */
+  static uint16_t GetReceiveLost() { return Lost; }
+
+private:
+  /**
+   * @brief Sets or clears the error mark of a receive buffer slot
+   */
+  static void Mark(const uint8_t Pos, const bool Error)
+  {
+    if(Error) ErrorMap[Pos / 8] |= (uint8_t) (1 << (Pos % 8));
+    else ErrorMap[Pos / 8] &= (uint8_t) ~(1 << (Pos % 8));
+  }
+
+  static RingBuffer<uint8_t, TxSize> SendBuff; /**< the send buffer */
+  static RingBuffer<uint8_t, RxSize> ReceiveBuff; /**< the receive buffer */
+  static uint16_t Lost; /**< the bytes overwritten or reported */
+  static const uint8_t ErrorMapSize =
+    (ErrorMode == UART_RX_ERROR_MARK) ? (RxSize + 7) / 8 : 1;
+  static uint8_t ErrorMap[ErrorMapSize]; /**< the receive buffer slots holding
+  a byte received with an error, used with UART_RX_ERROR_MARK only */
+};
+
+template <Uart_t Channel, uint8_t TxSize, uint8_t RxSize, CircBuffPolicy_t Policy,
+  uint32_t Baudrate, UartRxErrorMode_t ErrorMode>
+RingBuffer<uint8_t, TxSize>
+  Uart<Channel, TxSize, RxSize, Policy, Baudrate, ErrorMode>::SendBuff;
+
+template <Uart_t Channel, uint8_t TxSize, uint8_t RxSize, CircBuffPolicy_t Policy,
+  uint32_t Baudrate, UartRxErrorMode_t ErrorMode>
+RingBuffer<uint8_t, RxSize>
+  Uart<Channel, TxSize, RxSize, Policy, Baudrate, ErrorMode>::ReceiveBuff;
+
+template <Uart_t Channel, uint8_t TxSize, uint8_t RxSize, CircBuffPolicy_t Policy,
+  uint32_t Baudrate, UartRxErrorMode_t ErrorMode>
+uint16_t Uart<Channel, TxSize, RxSize, Policy, Baudrate, ErrorMode>::Lost;
+
+template <Uart_t Channel, uint8_t TxSize, uint8_t RxSize, CircBuffPolicy_t Policy,
+  uint32_t Baudrate, UartRxErrorMode_t ErrorMode>
+uint8_t Uart<Channel, TxSize, RxSize, Policy, Baudrate, ErrorMode>::ErrorMap[
+  Uart<Channel, TxSize, RxSize, Policy, Baudrate, ErrorMode>::ErrorMapSize];
+
+} // namespace uart
+
+#endif /* UART_HPP */
+/*****************************End of File ************************************/
@@ -23,7 +23,10 @@
 */
 static const UartConfig_t UartConfig[] =
 {
-  { UART_0, 9600, UART_STOP_BIT_1, UART_PARTIY_NO }
+  { UART_0, 9600, UART_STOP_BIT_1, UART_PARTIY_NO, UART_DATA_BITS_8,
+    UART_FLOW_CONTROL_NONE,
+    0x00, 0x00, CIRCBUFF_DROP_NEW, UART_RX_ERROR_DISCARD, UART_MPCM_OFF, 0x00,
+    0x00, UART_RX_MODE_RING, UART_FRAME_END_NONE, 0 }
 };
 /**********************************************************************
 * Function Definitions
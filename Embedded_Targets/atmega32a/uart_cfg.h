@@ -1,5 +1,5 @@
 /**
- * @file uart.h
+ * @file uart_cfg.h
  * @author Mohamed Hassanin
  * @brief A UART driver configuration header file.
  * @version 0.1
@@ -12,11 +12,91 @@
 * Includes
 **********************************************************************/
 #include <inttypes.h>
+#include "circ_buffer.h"
+#include "frame_pool.h"
 /**********************************************************************
 * Preprocessor constants
 **********************************************************************/
+#ifndef SYSTEM_FREQ
+#define SYSTEM_FREQ (12000000ul) /**< system frequency */
+#endif
+
+#define UART_BAUD_ERROR_MAX 20 /**< define the largest baudrate error accepted
+by the C++ layer (uart.hpp) at compile time, in per mille */
+
 #define UART_BUFF_SIZE 80 /**< define the number of bytes in a UART buffer */
 
+#define UART_CHANNEL_COUNT 1 /**< define the number of UART channels, it must
+match UART_MAX. When it's 1 the driver is specialised for a single channel and
+the channel dispatch folds into direct register access */
+
+#define UART_SERVICE_BUDGET UART_CHANNEL_COUNT /**< define the maximum number
+of active channels serviced by one Uart_ServiceAll call */
+
+#ifndef UART_CIRCBUFF_INLINE
+#define UART_CIRCBUFF_INLINE 1 /**< 1 to use the inline circular buffer fast
+path for the per byte operations, 0 to call the out-of-line functions */
+#endif
+
+#ifndef UART_DEV_ERROR_DETECT
+#define UART_DEV_ERROR_DETECT 1 /**< 1 to enable the development error checks
+(parameter checks), 0 to remove them in release builds */
+#endif
+
+#ifndef UART_LATENCY_TRACE
+#define UART_LATENCY_TRACE 0 /**< 1 to record the execution time of the update
+and string functions in a histogram per channel (see uart_trace.h), 0 to
+remove the trace points */
+#endif
+
+#ifndef UART_BYTE_TRACE
+#define UART_BYTE_TRACE 0 /**< 1 to measure the time sampled bytes spend in the
+send and receive buffers (see uart_trace.h), 0 to remove the measurement */
+#endif
+
+#define UART_BYTE_TRACE_INTERVAL 8 /**< define the sampling interval of the
+byte trace, one byte out of UART_BYTE_TRACE_INTERVAL is timestamped */
+
+#define UART_RX_HIGH_WATERMARK (UART_BUFF_SIZE - 16) /**< define the number of
+bytes in a receive buffer at which the peer is asked to stop sending */
+
+#define UART_RX_LOW_WATERMARK (UART_BUFF_SIZE / 4) /**< define the number of
+bytes in a receive buffer at which the peer is allowed to send again */
+
+#define UART_XON 0x11 /**< define the XON control character (DC1) */
+#define UART_XOFF 0x13 /**< define the XOFF control character (DC3) */
+
+#define UART_AUTOBAUD_PRESCALER 1 /**< define the prescaler between the system
+clock and the timer whose timestamps are passed to Uart_AutobaudCapture */
+
+#ifndef UART_FRAME_MODE
+#define UART_FRAME_MODE 0 /**< 1 to add the frame transfers (Uart_SendFrame,
+Uart_ReceiveFrame) and UART_RX_MODE_FRAME, 0 to remove them and their pools */
+#endif
+
+#define UART_FRAME_SIZE 32 /**< define the number of bytes in a frame */
+
+#define UART_FRAME_COUNT 4 /**< define the number of frames of a channel per
+direction, at most FRAME_POOL_MAX_FRAMES */
+
+#define UART_FRAME_LOW_WATERMARK (UART_FRAME_COUNT / 2) /**< define the number
+of receive frames in use at which the peer is allowed to send again, it's
+asked to stop when the last free frame is being filled */
+
+#define UART_FRAME_END_NONE 0xFFFF /**< no byte ends a received frame */
+
+#ifndef UART_PINGPONG_MODE
+#define UART_PINGPONG_MODE 0 /**< 1 to add the double-buffered reception
+(Uart_ReceiveBurst) and UART_RX_MODE_PINGPONG, 0 to remove it and its buffers */
+#endif
+
+#define UART_PINGPONG_SIZE 64 /**< define the number of bytes in each of the
+two linear receive buffers of a channel */
+
+#define UART_PINGPONG_HIGH_WATERMARK (UART_PINGPONG_SIZE - 16) /**< define the
+number of bytes in the buffer being filled at which the peer is asked to stop
+sending while the application holds the other buffer */
+
 #define UART_MODULE_ID 0x01 /**< define the module id to use in 
 error handling */
 /**********************************************************************
@@ -42,6 +122,72 @@ typedef enum
   UART_PARTIY_ODD, 
 } UartParity_t;
 
+/**
+ * Defines the possible flow control options
+ */
+typedef enum
+{
+  UART_FLOW_CONTROL_NONE, /**< no flow control */
+  UART_FLOW_CONTROL_XON_XOFF, /**< in-band software flow control */
+  UART_FLOW_CONTROL_RTS_CTS, /**< hardware flow control through GPIO hooks */
+} UartFlowControl_t;
+
+/**
+ * Defines the possible number of data bits in a frame
+ */
+typedef enum
+{
+  UART_DATA_BITS_5,
+  UART_DATA_BITS_6,
+  UART_DATA_BITS_7,
+  UART_DATA_BITS_8,
+  UART_DATA_BITS_9,
+} UartDataBits_t;
+
+/**
+ * Defines what happens to a byte received with a frame, overrun or parity
+ * error
+ */
+typedef enum
+{
+  UART_RX_ERROR_DISCARD, /**< the byte is discarded */
+  UART_RX_ERROR_MARK, /**< the byte is stored and its position is marked */
+} UartRxErrorMode_t;
+
+/**
+ * Defines the multi-processor communication mode options
+ */
+typedef enum
+{
+  UART_MPCM_OFF, /**< normal mode */
+  UART_MPCM_ON, /**< addressed bus, the 9th bit marks the address frames and
+  the data frames for other nodes are filtered. The data is 8 bits */
+} UartMpcm_t;
+
+/**
+ * Defines where the received bytes are stored
+ */
+typedef enum
+{
+  UART_RX_MODE_RING, /**< in the receive buffer, byte by byte */
+  UART_RX_MODE_FRAME, /**< in frames handed to the application whole, needs
+  UART_FRAME_MODE and at most 8 data bits */
+  UART_RX_MODE_PINGPONG, /**< in two linear buffers, one is filled while the
+  application processes the other, needs UART_PINGPONG_MODE and at most 8
+  data bits */
+} UartRxMode_t;
+
+/**
+ * A hook to drive a flow control or transceiver pin, Level is 1 to assert
+ * the pin
+ */
+typedef void (*UartPinWrite_t)(uint8_t Level);
+
+/**
+ * A hook to read a flow control pin, it returns 1 if the pin is asserted
+ */
+typedef uint8_t (*UartPinRead_t)(void);
+
 /**
 * Defines an enumerated list of all the uart pripherals on the MCU
 * device. The last element is used to specify the maximum number of
@@ -60,6 +206,21 @@ typedef struct
   uint32_t Baudrate; /**< the UART baudrate */
   UartStopBit_t StopBit; /**< the UART number of stop bits */
   UartParity_t Parity; /**< the UART parity option */
+  UartDataBits_t DataBits; /**< the UART number of data bits */
+  UartFlowControl_t FlowControl; /**< the UART flow control option */
+  UartPinWrite_t RtsWrite; /**< drives RTS, used with RTS/CTS only */
+  UartPinRead_t CtsRead; /**< reads CTS, used with RTS/CTS only */
+  CircBuffPolicy_t ReceivePolicy; /**< the receive buffer overflow policy */
+  UartRxErrorMode_t RxErrorMode; /**< the handling of the erroneous bytes */
+  UartMpcm_t Mpcm; /**< the multi-processor communication mode option */
+  uint8_t Address; /**< the node address, used with UART_MPCM_ON only */
+  UartPinWrite_t DriverEnable; /**< drives the RS-485 transceiver DE/RE pin,
+  0x00 if the channel is not half-duplex */
+  UartRxMode_t RxMode; /**< where the received bytes are stored */
+  uint16_t FrameEnd; /**< the byte that ends a received frame (kept as its
+  last byte), UART_FRAME_END_NONE if frames end on full or idle only */
+  uint8_t FrameIdleTicks; /**< the number of Uart_ReceiveUpdate calls
+  without a byte that end a received frame or burst, 0 to disable */
 }UartConfig_t;
 
 /******************************************************************************
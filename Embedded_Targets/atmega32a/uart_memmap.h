@@ -9,19 +9,39 @@
 #ifndef UART_MEMMAP_H
 #define UART_MEMMAP_H
 
+#include <inttypes.h>
+
+#ifndef UART_HOST_REGS
+#define UART_HOST_REGS 0 /**< 1 to map the registers into RAM (UartHostRegs)
+for the host checks, 0 for the MCU */
+#endif
+
+#if (UART_HOST_REGS == 1)
+extern volatile uint8_t UartHostRegs[0x60]; /**< the registers of a host check */
+#define UART_REG(Address) (&UartHostRegs[(Address)])
+#else
+#define UART_REG(Address) ((volatile uint8_t*) (Address))
+#endif
+
 #define UART_UPPER_BOUND_ADDRESS_0 UDR
-#define UDR ((volatile uint8_t*) 0x002C)
+#define UDR UART_REG(0x002C)
 
-#define UCSRA ((volatile uint8_t*) 0x002B)
-#define UCSRB ((volatile uint8_t*) 0x002A)
-#define UBRRL ((volatile uint8_t*) 0x0029)
+#define UCSRA UART_REG(0x002B)
+#define UCSRB UART_REG(0x002A)
+#define UBRRL UART_REG(0x0029)
 #define UART_LOWER_BOUND_ADDRESS_0 UBRRL
 
 #define UART_UPPER_BOUND_ADDRESS_1 UBRRH
-#define UBRRH ((volatile uint8_t*) 0x0040)
-#define UCSRC ((volatile uint8_t*) 0x0040)
+#define UBRRH UART_REG(0x0040)
+#define UCSRC UART_REG(0x0040)
 #define UART_LOWER_BOUND_ADDRESS_1 UBRRH
 
+/* Timer1, the cycle counter of the latency trace */
+#define TCNT1H UART_REG(0x004D)
+#define TCNT1L UART_REG(0x004C)
+#define TCCR1A UART_REG(0x004F)
+#define TCCR1B UART_REG(0x004E)
+
 /* UCSRA */
 #define RXC     7
 #define TXC     6
@@ -52,5 +72,8 @@
 #define UCSZ0   1
 #define UCPOL   0
 
+/* TCCR1B */
+#define CS10    0
+
 #endif
 /*****************************End of File ************************************/
@@ -0,0 +1,476 @@
+/**
+ * @file uart_trace.c
+ * @author Mohamed Hassanin
+ * @brief A latency trace for the UART driver. It records the execution time
+ * of the update and string functions and the time bytes spend in the buffers
+ * in a histogram per channel.
+ * @version 0.1
+ * @date 2021-03-08
+ */
+#if !defined(__AVR__)
+#define _POSIX_C_SOURCE 199309L /**< for clock_gettime */
+#endif
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "uart_trace.h"
+
+#if (UART_LATENCY_TRACE == 1) || (UART_BYTE_TRACE == 1)
+
+#if !defined(__AVR__)
+#include <time.h>
+#endif
+/******************************************************************************
+ * typedefs
+ ******************************************************************************/
+/**
+ * @brief The histogram of a trace point of a channel. The bucket b counts
+ * the measurements of b significant bits, i.e. from 2^(b-1) to 2^b - 1.
+ */
+typedef struct
+{
+  uint32_t Count; /**< the number of measurements */
+  UartTraceCycles_t Min; /**< the shortest measurement */
+  UartTraceCycles_t Max; /**< the longest measurement */
+  uint16_t Buckets[UART_TRACE_BUCKETS]; /**< the log2 histogram */
+} UartTraceHist_t;
+
+/**
+ * @brief The byte being measured in a buffer. Time is written before Pos so
+ * a consumer that sees Pos sees its timestamp.
+ */
+typedef struct
+{
+  UartTraceCycles_t Time; /**< the time the byte entered the buffer */
+  volatile uint8_t Pos; /**< its buffer position, UART_TRACE_NO_SAMPLE if
+  none is being measured */
+  uint8_t Countdown; /**< the number of bytes to skip before the next one */
+} UartTraceSample_t;
+/******************************************************************************
+ * Preprocessor constants
+ ******************************************************************************/
+#define UART_TRACE_NO_SAMPLE 0xFF /**< no byte is being measured */
+/******************************************************************************
+* Module Variable Definitions
+ ******************************************************************************/
+/**
+ * brief the histograms of every trace point of every channel
+ */
+static UartTraceHist_t UartTraceHists[UART_MAX][UART_TRACE_POINT_MAX];
+
+/**
+ * brief the bytes being measured in the send and receive buffers
+ */
+static UartTraceSample_t UartTraceSamples[UART_MAX][2];
+
+/**
+ * brief the clock of the byte trace, 0x00 for UartTrace_Now
+ */
+static UartTraceClock_t UartTraceByteClock;
+
+/**
+ * brief compile time check that UART_TRACE_NO_SAMPLE is not a buffer position
+ */
+typedef char UartTraceNoSampleCheck_t[(UART_BUFF_SIZE <= UART_TRACE_NO_SAMPLE) ? 1 : -1];
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static uint8_t UartTrace_InRange(const uint8_t Pos, const uint8_t First,
+  const uint8_t Count);
+static UartTraceCycles_t UartTrace_ByteNow(void);
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+#if !defined(__AVR__)
+/******************************************************************************
+* Function : UartTrace_Now()
+*//**
+* \b Description:
+* This function is used to read the monotonic clock of the host in
+* nanoseconds. It wraps around every ~4.3 s so only differences of less than
+* that are meaningful. <br>
+* @return UartTraceCycles_t the current time
+*******************************************************************************/
+extern UartTraceCycles_t
+UartTrace_Now(void)
+{
+  struct timespec Now;
+
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+
+  return (UartTraceCycles_t) ((uint32_t) Now.tv_sec * 1000000000ul +
+    (uint32_t) Now.tv_nsec);
+}
+#endif
+
+/******************************************************************************
+* Function : UartTrace_Init()
+*//**
+* \b Description:
+* This function is used to clear the histograms of all the channels. On the
+* target it also starts Timer1 free running at the system clock, skip it and
+* call UartTrace_Reset instead if Timer1 is started by the application. <br>
+* POST-CONDITION: Timer1 counts CPU cycles <br>
+* @return void
+*
+* \b Example:
+* @code
+* UartTrace_Init();
+* Uart_Init(Uart_GetConfig());
+* @endcode
+* @see UartTrace_Reset
+*******************************************************************************/
+extern void
+UartTrace_Init(void)
+{
+#if defined(__AVR__)
+  *TCCR1A = 0;
+  *TCCR1B = 1 << CS10;
+#endif
+
+  for(uint8_t Uart = 0; Uart < UART_MAX; Uart++)
+    {
+      UartTrace_Reset((Uart_t) Uart);
+    }
+}
+
+/******************************************************************************
+* Function : UartTrace_Reset()
+*//**
+* \b Description:
+* This function is used to clear the histograms of a channel, e.g. to start
+* a new measurement window, and to drop the bytes being measured. <br>
+* @param Uart the Uart Id
+* @return void
+*******************************************************************************/
+extern void
+UartTrace_Reset(const Uart_t Uart)
+{
+  if(!(Uart < UART_MAX)) return;
+
+  for(uint8_t Dir = 0; Dir < 2; Dir++)
+    {
+      UartTraceSamples[Uart][Dir].Pos = UART_TRACE_NO_SAMPLE;
+      UartTraceSamples[Uart][Dir].Countdown = 0;
+    }
+
+  for(uint8_t Point = 0; Point < UART_TRACE_POINT_MAX; Point++)
+    {
+      UartTraceHist_t * const Hist = &UartTraceHists[Uart][Point];
+
+      Hist->Count = 0;
+      Hist->Min = (UartTraceCycles_t) ~0u;
+      Hist->Max = 0;
+      for(uint8_t b = 0; b < UART_TRACE_BUCKETS; b++)
+        {
+          Hist->Buckets[b] = 0;
+        }
+    }
+}
+
+/******************************************************************************
+* Function : UartTrace_Record()
+*//**
+* \b Description:
+* This function is used to record a measurement, it's called by the
+* UART_TRACE_EXIT trace points. When a bucket is about to overflow all the
+* buckets are halved so the shape of the histogram is kept. <br>
+* @param Uart the Uart Id
+* @param Point the trace point
+* @param Cycles the measured time
+* @return void
+*
+* @see UART_TRACE_EXIT
+*******************************************************************************/
+extern void
+UartTrace_Record(
+  const Uart_t Uart,
+  const UartTracePoint_t Point,
+  const UartTraceCycles_t Cycles)
+{
+  UartTraceHist_t * const Hist = &UartTraceHists[Uart][Point];
+  UartTraceCycles_t Value = Cycles;
+  uint8_t Bucket = 0;
+
+  while(Value != 0)
+    {
+      Value >>= 1;
+      Bucket++;
+    }
+
+  if(Hist->Buckets[Bucket] == UINT16_MAX)
+    {
+      for(uint8_t b = 0; b < UART_TRACE_BUCKETS; b++)
+        {
+          Hist->Buckets[b] >>= 1;
+        }
+    }
+
+  Hist->Buckets[Bucket]++;
+  Hist->Count++;
+  if(Cycles < Hist->Min) Hist->Min = Cycles;
+  if(Cycles > Hist->Max) Hist->Max = Cycles;
+}
+
+/******************************************************************************
+* Function : UartTrace_GetStats()
+*//**
+* \b Description:
+* This function is used to get the number of measurements and the shortest
+* and longest ones of a trace point. The longest one is the observed worst
+* case execution time. <br>
+* @param Uart the Uart Id
+* @param Point the trace point
+* @param Stats a pointer to store the summary in
+* @return uint8_t 1 if there are measurements, 0 otherwise
+*
+* \b Example:
+* @code
+* UartTraceStats_t Stats;
+* if(UartTrace_GetStats(UART_0, UART_TRACE_RECEIVE_UPDATE, &Stats) == 1)
+*   {
+*     Log(Stats.Max);
+*   }
+* @endcode
+*******************************************************************************/
+extern uint8_t
+UartTrace_GetStats(
+  const Uart_t Uart,
+  const UartTracePoint_t Point,
+  UartTraceStats_t * const Stats)
+{
+  if(!(Uart < UART_MAX && Point < UART_TRACE_POINT_MAX && Stats != 0x00))
+    return 0;
+
+  const UartTraceHist_t * const Hist = &UartTraceHists[Uart][Point];
+
+  Stats->Count = Hist->Count;
+  Stats->Min = Hist->Min;
+  Stats->Max = Hist->Max;
+
+  return (Hist->Count != 0) ? 1 : 0;
+}
+
+/******************************************************************************
+* Function : UartTrace_GetPercentile()
+*//**
+* \b Description:
+* This function is used to get an upper bound of a percentile of a trace
+* point. The bound is the top of the histogram bucket holding the percentile,
+* clamped to the measured range, so it's exact to within a factor of two. <br>
+* @param Uart the Uart Id
+* @param Point the trace point
+* @param Percent the percentile (e.g. 50, 99), 100 gives the maximum
+* @return UartTraceCycles_t the percentile, 0 if there are no measurements
+*
+* \b Example:
+* @code
+* UartTraceCycles_t P99 = UartTrace_GetPercentile(UART_0,
+*   UART_TRACE_SEND_UPDATE, 99);
+* @endcode
+*******************************************************************************/
+extern UartTraceCycles_t
+UartTrace_GetPercentile(
+  const Uart_t Uart,
+  const UartTracePoint_t Point,
+  const uint8_t Percent)
+{
+  if(!(Uart < UART_MAX && Point < UART_TRACE_POINT_MAX)) return 0;
+
+  const UartTraceHist_t * const Hist = &UartTraceHists[Uart][Point];
+  uint32_t Total = 0;
+  uint32_t Target;
+  uint32_t Sum = 0;
+  uint8_t b;
+
+  for(b = 0; b < UART_TRACE_BUCKETS; b++)
+    {
+      Total += Hist->Buckets[b];
+    }
+
+  if(Total == 0) return 0;
+
+  Target = (Total * (Percent > 100 ? 100 : Percent) + 99) / 100;
+  if(Target == 0) Target = 1;
+
+  for(b = 0; b < UART_TRACE_BUCKETS - 1; b++)
+    {
+      Sum += Hist->Buckets[b];
+      if(Sum >= Target) break;
+    }
+
+  //the last bucket has no power of two top that fits in UartTraceCycles_t
+  if(b == UART_TRACE_BUCKETS - 1) return Hist->Max;
+
+  UartTraceCycles_t Top = (UartTraceCycles_t) ((1ul << b) - 1);
+
+  if(Top > Hist->Max) Top = Hist->Max;
+  if(Top < Hist->Min) Top = Hist->Min;
+
+  return Top;
+}
+
+/******************************************************************************
+* Function : UartTrace_GetHistogram()
+*//**
+* \b Description:
+* This function is used to copy the raw histogram of a trace point, e.g. to
+* send it to a host for plotting. <br>
+* @param Uart the Uart Id
+* @param Point the trace point
+* @param Buckets an array of UART_TRACE_BUCKETS counters to store it in
+* @return uint8_t 1 if the histogram is copied, 0 otherwise
+*******************************************************************************/
+extern uint8_t
+UartTrace_GetHistogram(
+  const Uart_t Uart,
+  const UartTracePoint_t Point,
+  uint16_t * const Buckets)
+{
+  if(!(Uart < UART_MAX && Point < UART_TRACE_POINT_MAX && Buckets != 0x00))
+    return 0;
+
+  for(uint8_t b = 0; b < UART_TRACE_BUCKETS; b++)
+    {
+      Buckets[b] = UartTraceHists[Uart][Point].Buckets[b];
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : UartTrace_SetByteClock()
+*//**
+* \b Description:
+* This function is used to set the clock of the byte trace. The bytes may wait
+* in the buffers for many milliseconds, longer than the Timer1 counter of the
+* target wraps, so a slower clock (e.g. the scheduler tick) is set there. <br>
+* @param Clock a function returning the current time, 0x00 for UartTrace_Now
+* @return void
+*
+* \b Example:
+* @code
+* UartTrace_SetByteClock(Scheduler_GetTick);
+* @endcode
+*******************************************************************************/
+extern void
+UartTrace_SetByteClock(const UartTraceClock_t Clock)
+{
+  UartTraceByteClock = Clock;
+}
+
+/******************************************************************************
+* Function : UartTrace_ByteIn()
+*//**
+* \b Description:
+* This function is used to tell the byte trace that bytes entered a buffer,
+* it's called by the UART_BYTE_TRACE_IN trace points. One byte out of
+* UART_BYTE_TRACE_INTERVAL is picked and timestamped if no other byte of the
+* buffer is being measured. A measured byte that is overwritten before it's
+* dequeued (CIRCBUFF_OVERWRITE_OLDEST) is dropped. <br>
+* @param Uart the Uart Id
+* @param Point UART_TRACE_TX_QUEUE or UART_TRACE_RX_QUEUE
+* @param Pos the buffer position of the first byte
+* @param Count the number of bytes
+* @return void
+*
+* @see UartTrace_ByteOut
+*******************************************************************************/
+extern void
+UartTrace_ByteIn(
+  const Uart_t Uart,
+  const UartTracePoint_t Point,
+  const uint8_t Pos,
+  const uint8_t Count)
+{
+  UartTraceSample_t * const Sample =
+    &UartTraceSamples[Uart][Point - UART_TRACE_TX_QUEUE];
+
+  if(Count == 0) return;
+
+  //the measured byte was overwritten before being dequeued
+  if(Sample->Pos != UART_TRACE_NO_SAMPLE &&
+     UartTrace_InRange(Sample->Pos, Pos, Count) == 1)
+    {
+      Sample->Pos = UART_TRACE_NO_SAMPLE;
+    }
+
+  if(Sample->Countdown >= Count)
+    {
+      Sample->Countdown -= Count;
+      return;
+    }
+
+  uint8_t Offset = Sample->Countdown;
+  uint16_t Next = (uint16_t) Pos + Offset;
+
+  //the bytes after the picked one count towards the next pick
+  Sample->Countdown = (uint8_t) (UART_BYTE_TRACE_INTERVAL - 1 -
+    (Count - 1 - Offset) % UART_BYTE_TRACE_INTERVAL);
+
+  //a single byte is measured at a time, this pick is skipped
+  if(Sample->Pos != UART_TRACE_NO_SAMPLE) return;
+
+  Sample->Time = UartTrace_ByteNow();
+  Sample->Pos = (uint8_t) ((Next >= UART_BUFF_SIZE) ? (Next - UART_BUFF_SIZE) : Next);
+}
+
+/******************************************************************************
+* Function : UartTrace_ByteOut()
+*//**
+* \b Description:
+* This function is used to tell the byte trace that bytes left a buffer, it's
+* called by the UART_BYTE_TRACE_OUT trace points. If the measured byte is
+* among them the time it spent in the buffer is recorded. <br>
+* @param Uart the Uart Id
+* @param Point UART_TRACE_TX_QUEUE or UART_TRACE_RX_QUEUE
+* @param Pos the buffer position of the first byte
+* @param Count the number of bytes
+* @return void
+*
+* @see UartTrace_ByteIn
+*******************************************************************************/
+extern void
+UartTrace_ByteOut(
+  const Uart_t Uart,
+  const UartTracePoint_t Point,
+  const uint8_t Pos,
+  const uint8_t Count)
+{
+  UartTraceSample_t * const Sample =
+    &UartTraceSamples[Uart][Point - UART_TRACE_TX_QUEUE];
+
+  if(Sample->Pos == UART_TRACE_NO_SAMPLE ||
+     UartTrace_InRange(Sample->Pos, Pos, Count) == 0) return;
+
+  UartTrace_Record(Uart, Point, (UartTraceCycles_t) (UartTrace_ByteNow() - Sample->Time));
+  Sample->Pos = UART_TRACE_NO_SAMPLE;
+}
+
+/**
+ * @brief Checks if a buffer position is one of Count positions starting at
+ * First, the positions wrap at UART_BUFF_SIZE.
+ * 
+ * @return uint8_t 1 if it is, 0 otherwise
+ */
+static uint8_t
+UartTrace_InRange(const uint8_t Pos, const uint8_t First, const uint8_t Count)
+{
+  uint8_t Offset = (Pos >= First) ? (uint8_t) (Pos - First) :
+    (uint8_t) (Pos + UART_BUFF_SIZE - First);
+
+  return (Offset < Count) ? 1 : 0;
+}
+
+/**
+ * @brief Reads the clock of the byte trace
+ * 
+ */
+static UartTraceCycles_t
+UartTrace_ByteNow(void)
+{
+  return (UartTraceByteClock != 0x00) ? UartTraceByteClock() : UartTrace_Now();
+}
+
+#endif
+/*****************************End of File ************************************/
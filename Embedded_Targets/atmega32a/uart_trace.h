@@ -0,0 +1,157 @@
+/**
+ * @file uart_trace.h
+ * @author Mohamed Hassanin
+ * @brief A latency trace for the UART driver. It records the execution time
+ * of the update and string functions and the time bytes spend in the buffers
+ * in a histogram per channel.
+ * @version 0.1
+ * @date 2021-03-08
+ */
+#ifndef UART_TRACE_H
+#define UART_TRACE_H
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+#include "uart_cfg.h"
+#if defined(__AVR__)
+#include "uart_memmap.h"
+#endif
+/******************************************************************************
+ * typedefs
+ ******************************************************************************/
+#if defined(__AVR__)
+/**
+ * @brief A time measured in Timer1 counts (CPU cycles when the timer runs
+ * without a prescaler)
+ */
+typedef uint16_t UartTraceCycles_t;
+#else
+/**
+ * @brief A time measured in nanoseconds on the host
+ */
+typedef uint32_t UartTraceCycles_t;
+#endif
+
+/**
+ * @brief The measured trace points
+ */
+typedef enum
+{
+  UART_TRACE_SEND_UPDATE, /**< Uart_SendUpdate and the send of Uart_ServiceAll */
+  UART_TRACE_RECEIVE_UPDATE, /**< Uart_ReceiveUpdate and the receive of
+  Uart_ServiceAll */
+  UART_TRACE_SEND_STRING, /**< Uart_SendString */
+  UART_TRACE_RECEIVE_STRING, /**< Uart_ReceiveString */
+  UART_TRACE_TX_QUEUE, /**< a byte from its enqueue to its write to the data
+  register, measured with the byte clock */
+  UART_TRACE_RX_QUEUE, /**< a byte from its read from the data register to
+  its dequeue, measured with the byte clock */
+  UART_TRACE_POINT_MAX
+} UartTracePoint_t;
+
+/**
+ * @brief A clock used to timestamp the sampled bytes
+ */
+typedef UartTraceCycles_t (*UartTraceClock_t)(void);
+
+/**
+ * @brief The summary of a histogram
+ */
+typedef struct
+{
+  uint32_t Count; /**< the number of measurements */
+  UartTraceCycles_t Min; /**< the shortest measurement */
+  UartTraceCycles_t Max; /**< the longest measurement (worst case) */
+} UartTraceStats_t;
+/******************************************************************************
+ * Preprocessor macros
+ ******************************************************************************/
+#define UART_TRACE_BUCKETS (sizeof(UartTraceCycles_t) * 8 + 1) /**< the number
+of histogram buckets, the bucket b counts the times of b significant bits */
+
+#if (UART_LATENCY_TRACE == 1)
+/**
+ * Starts a measurement, it declares the variable Start holding the entry time.
+ */
+#define UART_TRACE_ENTER(Start) UartTraceCycles_t Start = UartTrace_Now()
+/**
+ * Ends a measurement started by UART_TRACE_ENTER and records it.
+ */
+#define UART_TRACE_EXIT(Uart, Point, Start) \
+  UartTrace_Record((Uart), (Point), (UartTraceCycles_t) (UartTrace_Now() - (Start)))
+#else
+#define UART_TRACE_ENTER(Start)
+#define UART_TRACE_EXIT(Uart, Point, Start)
+#endif
+
+#if (UART_BYTE_TRACE == 1)
+/**
+ * Declares the variable Pos holding a buffer position for the byte trace.
+ */
+#define UART_BYTE_TRACE_MARK(Pos, Value) const uint8_t Pos = (Value)
+/**
+ * Count bytes starting at the buffer position Pos entered the buffer of Point.
+ */
+#define UART_BYTE_TRACE_IN(Uart, Point, Pos, Count) \
+  UartTrace_ByteIn((Uart), (Point), (Pos), (Count))
+/**
+ * Count bytes starting at the buffer position Pos left the buffer of Point.
+ */
+#define UART_BYTE_TRACE_OUT(Uart, Point, Pos, Count) \
+  UartTrace_ByteOut((Uart), (Point), (Pos), (Count))
+#else
+#define UART_BYTE_TRACE_MARK(Pos, Value)
+#define UART_BYTE_TRACE_IN(Uart, Point, Pos, Count)
+#define UART_BYTE_TRACE_OUT(Uart, Point, Pos, Count)
+#endif
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if (UART_LATENCY_TRACE == 1) || (UART_BYTE_TRACE == 1)
+
+#if defined(__AVR__)
+/**
+ * @brief Reads the Timer1 counter, the low byte is read first so the high
+ * byte is latched with it.
+ */
+static inline UartTraceCycles_t
+UartTrace_Now(void)
+{
+  uint8_t Low = *TCNT1L;
+  return (UartTraceCycles_t) (Low | (*TCNT1H << 8));
+}
+#else
+extern UartTraceCycles_t UartTrace_Now(void);
+#endif
+
+extern void UartTrace_Init(void);
+extern void UartTrace_Reset(const Uart_t Uart);
+extern void UartTrace_Record(const Uart_t Uart, const UartTracePoint_t Point,
+  const UartTraceCycles_t Cycles);
+extern uint8_t UartTrace_GetStats(const Uart_t Uart, const UartTracePoint_t Point,
+  UartTraceStats_t * const Stats);
+extern UartTraceCycles_t UartTrace_GetPercentile(const Uart_t Uart,
+  const UartTracePoint_t Point, const uint8_t Percent);
+extern uint8_t UartTrace_GetHistogram(const Uart_t Uart,
+  const UartTracePoint_t Point, uint16_t * const Buckets);
+
+extern void UartTrace_SetByteClock(const UartTraceClock_t Clock);
+extern void UartTrace_ByteIn(const Uart_t Uart, const UartTracePoint_t Point,
+  const uint8_t Pos, const uint8_t Count);
+extern void UartTrace_ByteOut(const Uart_t Uart, const UartTracePoint_t Point,
+  const uint8_t Pos, const uint8_t Count);
+
+#endif
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* UART_TRACE_H */
+/*****************************End of File ************************************/
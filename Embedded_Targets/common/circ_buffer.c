@@ -0,0 +1,1136 @@
+/**
+ * @file circ_buffer.c
+ * @author Mohamed Hassanin 
+ * @brief A circular buffer/queue module. 
+ * Note: one space is wasted in the buffer to know if it's empty
+ * @version 0.1
+ * @date 2021-02-15
+ * 
+ * @copyright Copyright (c) 2021
+ * 
+ */
+/*********************************************************************
+ * definitions
+**********************************************************************/
+#define NULL 0x0
+
+/*******************************************************************
+ * Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "circ_buffer.h"
+#if (CIRCBUFF_KERNEL == CIRCBUFF_KERNEL_SSE2)
+#include <emmintrin.h>
+#endif
+
+/*********************************************************************
+ * typedefs
+**********************************************************************/
+#if (CIRCBUFF_KERNEL != CIRCBUFF_KERNEL_SCALAR)
+/**
+ * @brief The machine word the SWAR kernels work on
+ */
+typedef uintptr_t CircBuffWord_t;
+#endif
+
+/*********************************************************************
+ * Prototypes
+**********************************************************************/
+static uint8_t CircBuff_IsEmpty(CircBuffState_t* Buff);
+static inline void CircBuff_CopyRun(uint8_t * Dst, const uint8_t * Src,
+  uint8_t Count);
+static inline uint8_t CircBuff_FindRun(const uint8_t * Src, uint8_t Count,
+  uint8_t Data);
+
+/*********************************************************************
+ * Private functions definitions
+**********************************************************************/
+/*********************************************************************
+* Function : CircBuff_IsEmpty()
+*//**
+* \b Description:
+*
+* Utility function is used to check if the circuler buffer is empty
+*
+* @param Buff a valid pointer to the circuler buffer state
+*
+* @return uint8_t 1 if the buffer is empty, 0 otherwise
+*
+**********************************************************************/
+static uint8_t 
+CircBuff_IsEmpty(CircBuffState_t* Buf)
+{
+  // define empty as head == tail
+  return (Buf->Front == Buf->Rear);
+}
+
+/*********************************************************************
+* Function : CircBuff_CopyRun()
+*//**
+* \b Description:
+*
+* Utility function is used to copy a contiguous run of bytes, a 16 byte
+* vector or a machine word at a time depending on CIRCBUFF_KERNEL, and the
+* tail byte by byte. The loads and stores are unaligned.
+*
+* @param Dst a valid pointer to store Count bytes in
+* @param Src a valid pointer to Count bytes
+* @param Count the number of bytes to copy
+*
+**********************************************************************/
+static inline void
+CircBuff_CopyRun(uint8_t * Dst, const uint8_t * Src, uint8_t Count)
+{
+  uint8_t i = 0;
+
+#if (CIRCBUFF_KERNEL == CIRCBUFF_KERNEL_SSE2)
+  for(; (uint8_t) (Count - i) >= 16; i += 16)
+    {
+      _mm_storeu_si128((__m128i *) &Dst[i],
+        _mm_loadu_si128((const __m128i *) &Src[i]));
+    }
+#endif
+#if (CIRCBUFF_KERNEL != CIRCBUFF_KERNEL_SCALAR)
+  for(; (uint8_t) (Count - i) >= sizeof(CircBuffWord_t); i += sizeof(CircBuffWord_t))
+    {
+      CircBuffWord_t Word;
+
+      __builtin_memcpy(&Word, &Src[i], sizeof(Word));
+      __builtin_memcpy(&Dst[i], &Word, sizeof(Word));
+    }
+#endif
+
+  for(; i < Count; i++) Dst[i] = Src[i];
+}
+
+/*********************************************************************
+* Function : CircBuff_FindRun()
+*//**
+* \b Description:
+*
+* Utility function is used to search a contiguous run of bytes for a byte.
+* The SWAR kernel XORs a word with the byte repeated, so a matching byte
+* becomes a zero byte, and (x - 0x01..01) & ~x & 0x80..80 flags the zero
+* bytes. A borrow may only flag a byte above a real zero byte, so on a
+* little endian host the lowest flag is always the first match. The SSE2
+* kernel compares 16 bytes at once and takes the lowest bit of the mask.
+*
+* @param Src a valid pointer to Count bytes
+* @param Count the number of bytes to search
+* @param Data the byte to search for
+*
+* @return uint8_t the index of the first match, Count if none
+*
+**********************************************************************/
+static inline uint8_t
+CircBuff_FindRun(const uint8_t * Src, uint8_t Count, uint8_t Data)
+{
+  uint8_t i = 0;
+
+#if (CIRCBUFF_KERNEL == CIRCBUFF_KERNEL_SSE2)
+  const __m128i Pattern = _mm_set1_epi8((char) Data);
+
+  for(; (uint8_t) (Count - i) >= 16; i += 16)
+    {
+      unsigned Mask = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(
+        _mm_loadu_si128((const __m128i *) &Src[i]), Pattern));
+
+      if(Mask != 0) return (uint8_t) (i + __builtin_ctz(Mask));
+    }
+#endif
+#if (CIRCBUFF_KERNEL != CIRCBUFF_KERNEL_SCALAR)
+  const CircBuffWord_t Ones = (CircBuffWord_t) -1 / 0xFF;
+  const CircBuffWord_t Highs = Ones << 7;
+  const CircBuffWord_t Repeated = Ones * Data;
+
+  for(; (uint8_t) (Count - i) >= sizeof(CircBuffWord_t); i += sizeof(CircBuffWord_t))
+    {
+      CircBuffWord_t Word;
+
+      __builtin_memcpy(&Word, &Src[i], sizeof(Word));
+      Word ^= Repeated;
+      Word = (Word - Ones) & ~Word & Highs;
+
+      if(Word != 0) return (uint8_t) (i + __builtin_ctzll(Word) / 8);
+    }
+#endif
+
+  for(; i < Count; i++)
+    {
+      if(Src[i] == Data) return i;
+    }
+
+  return Count;
+}
+
+/*********************************************************************
+ * Public functions definitions
+**********************************************************************/
+/*********************************************************************
+* Function : CircBuff_Create()
+*//**
+* \b Description:
+*
+* This function is used to create a circuler buffer.
+*
+* @param BuffData a valid pointer an allocated piece of memory for the buffer
+* @param Size the size of the piece of memory.
+*
+* @return CircBuff_t The created buffer.
+*
+* \b Example:
+* @code
+* uint8_t UartBuffer[MAX_UART_BUFF_SIZE];
+* CircBuff_t UartBuff = CircBuff_Create(UartBuffer, MAX_UART_BUFF_SIZE);
+* @endcode
+*
+**********************************************************************/
+extern CircBuff_t
+CircBuff_Create(uint8_t* BuffData, uint8_t Size) {
+  return CircBuff_CreatePolicy(BuffData, Size, CIRCBUFF_DROP_NEW);
+}
+
+/*********************************************************************
+* Function : CircBuff_CreatePolicy()
+*//**
+* \b Description:
+*
+* This function is used to create a circuler buffer with an overflow
+* policy that decides what happens to a byte enqueued into a full buffer.
+*
+* @param BuffData a valid pointer an allocated piece of memory for the buffer
+* @param Size the size of the piece of memory.
+* @param Policy the overflow policy of the buffer.
+*
+* @return CircBuff_t The created buffer.
+*
+* \b Example:
+* @code
+* uint8_t SensorBuffer[MAX_SENSOR_BUFF_SIZE];
+* CircBuff_t SensorBuff = CircBuff_CreatePolicy(SensorBuffer,
+*   MAX_SENSOR_BUFF_SIZE, CIRCBUFF_OVERWRITE_OLDEST);
+* @endcode
+*
+* @see CircBuff_Create
+* @see CircBuff_GetLost
+**********************************************************************/
+extern CircBuff_t
+CircBuff_CreatePolicy(uint8_t* BuffData, uint8_t Size,
+  CircBuffPolicy_t Policy) {
+  CircBuff_t Buff;
+  Buff.Data = BuffData;
+  Buff.Size = Size;
+  Buff.State = CircBuff_CreateState(Policy);
+
+  return Buff;
+}
+
+/*********************************************************************
+* Function : CircBuff_CreateState()
+*//**
+* \b Description:
+*
+* This function is used to create the state of an empty circuler buffer
+* whose memory and size are kept by the caller, for the *Sized functions.
+*
+* @param Policy the overflow policy of the buffer.
+*
+* @return CircBuffState_t The created buffer state.
+*
+* \b Example:
+* @code
+* static uint8_t RxData[CHANNELS][RX_SIZE];
+* static CircBuffState_t RxBuff[CHANNELS];
+* RxBuff[i] = CircBuff_CreateState(CIRCBUFF_REPORT);
+* CircBuff_EnqueueSized(&RxBuff[i], RxData[i], RX_SIZE, Byte);
+* @endcode
+*
+* @see CircBuff_CreatePolicy
+**********************************************************************/
+extern CircBuffState_t
+CircBuff_CreateState(CircBuffPolicy_t Policy)
+{
+  CircBuffState_t Buff;
+  Buff.Rear = 0;
+  Buff.Front = 0;
+  Buff.Policy = Policy;
+  Buff.Lost = 0;
+
+  return Buff;
+}
+
+/*********************************************************************
+* Function : CircBuff_Reset()
+*//**
+* \b Description:
+*
+* This function is used to reset a circuler buffer.
+*
+* @param Buff a valid pointer to the buffer
+*
+* @return void
+*
+* \b Example:
+* @code
+* uint8_t UartBuffer[MAX_UART_BUFF_SIZE];
+* CircBuff_t UartBuff = CircBuff_Create(UartBuffer, MAX_UART_BUFF_SIZE);
+* CircBuff_Enqueue(&UartBuff, 'a');
+* CircBuff_Reset(&UartBuff); //now it's empty again.
+* @endcode
+*
+* @see CircBuff_Create
+**********************************************************************/
+extern void 
+CircBuff_Reset(CircBuff_t* Buff)
+{
+  Buff->State.Front = 0;
+  Buff->State.Rear = 0;
+  Buff->State.Lost = 0;
+}
+
+/*********************************************************************
+* Function : CircBuff_Dequeue()
+*//**
+* \b Description:
+*
+* This function is used to dequeue from a circuler buffer
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Data a pointer to store the dequeued Data in.
+* @return uint8_t 1 if there's a valid Data returned, 0 otherwise
+*
+*
+* \b Example:
+* @code
+* uint8_t UartBuffer[MAX_UART_BUFF_SIZE];
+* CircBuff_t UartBuff = CircBuff_Create(UartBuffer, MAX_UART_BUFF_SIZE);
+* CircBuff_Enqueue(&UartBuff, 'a');
+* uint8_t RcvData;
+* CircBuff_Dequeue(&UartBuff, &RcvData); //RcvData now has 'a' and the buffer is empty
+* @endcode
+*
+* @see CircBuff_Create
+* @see CircBuff_Enqueue
+**********************************************************************/
+extern uint8_t 
+CircBuff_Dequeue(CircBuff_t* Buff, uint8_t * Data)
+{
+  uint8_t r = 0;
+
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL || Data == NULL) return r;
+#endif
+
+  r = CircBuff_DequeueInline(Buff, Data);
+
+  return r;
+}
+
+/*********************************************************************
+* Function : CircBuff_Enqueue()
+*//**
+* \b Description:
+*
+* This function is used to enqueue into a circuler buffer
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Data a byte to add to the queue.
+* @return uint8_t 1 if the byte is stored and 0 otherwise.
+*
+* \b Example:
+* @code
+* uint8_t UartBuffer[MAX_UART_BUFF_SIZE];
+* CircBuff_t UartBuff = CircBuff_Create(UartBuffer, MAX_UART_BUFF_SIZE);
+* CircBuff_Enqueue(&UartBuff, 'a'); // now the buffer has 'a'
+* @endcode
+*
+* @see CircBuff_Create
+**********************************************************************/
+extern uint8_t
+CircBuff_Enqueue(CircBuff_t* Buff, uint8_t Data)
+{
+  uint8_t r = 0;
+
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return r;
+#endif
+
+  r = CircBuff_EnqueueInline(Buff, Data);
+
+  return r;
+}
+
+/*********************************************************************
+* Function : CircBuff_EnqueueBulk()
+*//**
+* \b Description:
+*
+* This function is used to enqueue up to Count bytes into a circuler
+* buffer. The bytes are copied in at most two runs (see CIRCBUFF_KERNEL)
+* and the Front is moved once. The bytes that don't fit are not stored and
+* the overflow policy is not applied, it's meant for the buffers the
+* producer may not overrun, e.g. a send buffer.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Data a pointer to the bytes to add to the queue
+* @param Count the number of bytes to add
+* @return uint8_t the number of stored bytes
+*
+* \b Example:
+* @code
+* uint8_t n = CircBuff_EnqueueBulk(&UartBuff, (const uint8_t*) "AT\r", 3);
+* @endcode
+*
+* @see CircBuff_DequeueBulk
+**********************************************************************/
+extern uint8_t
+CircBuff_EnqueueBulk(CircBuff_t* Buff, const uint8_t * Data, uint8_t Count)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return 0;
+#endif
+
+  return CircBuff_EnqueueBulkSized(&Buff->State, Buff->Data, Buff->Size, Data,
+    Count);
+}
+
+/*********************************************************************
+* Function : CircBuff_EnqueueBulkSized()
+*//**
+* \b Description:
+*
+* This function is used to enqueue up to Count bytes into a circuler
+* buffer whose memory and size are kept by the caller.
+*
+* @param Buff a valid pointer to the circuler buffer state
+* @param BuffData the memory of the buffer
+* @param Size the size of the memory of the buffer
+* @param Data a pointer to the bytes to add to the queue
+* @param Count the number of bytes to add
+* @return uint8_t the number of stored bytes
+*
+* @see CircBuff_EnqueueBulk
+**********************************************************************/
+extern uint8_t
+CircBuff_EnqueueBulkSized(CircBuffState_t* Buff, uint8_t* BuffData,
+  uint8_t Size, const uint8_t * Data, uint8_t Count)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL || BuffData == NULL || Data == NULL) return 0;
+#endif
+
+  uint8_t Front = Buff->Front;
+  uint8_t Free = (uint8_t) (Size - 1 - CircBuff_Distance(Buff->Rear, Front, Size));
+
+  if(Count > Free) Count = Free;
+
+  uint8_t First = Size - Front;
+  if(First > Count) First = Count;
+
+  CircBuff_CopyRun(&BuffData[Front], Data, First);
+  CircBuff_CopyRun(BuffData, &Data[First], (uint8_t) (Count - First));
+
+  uint16_t Pos = (uint16_t) Front + Count;
+  if(Pos >= Size) Pos -= Size;
+
+  Buff->Front = (uint8_t) Pos;
+
+  return Count;
+}
+
+/*********************************************************************
+* Function : CircBuff_DequeueBulk()
+*//**
+* \b Description:
+*
+* This function is used to dequeue up to Count bytes from a circuler
+* buffer. The bytes are copied in at most two runs (see CIRCBUFF_KERNEL)
+* and the Rear is moved once.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Data a pointer to store the dequeued bytes in, Count bytes
+* @param Count the number of bytes to dequeue
+* @return uint8_t the number of dequeued bytes
+*
+* @see CircBuff_EnqueueBulk
+* @see CircBuff_PeekSpan
+**********************************************************************/
+extern uint8_t
+CircBuff_DequeueBulk(CircBuff_t* Buff, uint8_t * Data, uint8_t Count)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return 0;
+#endif
+
+  return CircBuff_DequeueBulkSized(&Buff->State, Buff->Data, Buff->Size, Data,
+    Count);
+}
+
+/*********************************************************************
+* Function : CircBuff_DequeueBulkSized()
+*//**
+* \b Description:
+*
+* This function is used to dequeue up to Count bytes from a circuler
+* buffer whose memory and size are kept by the caller.
+*
+* @param Buff a valid pointer to the circuler buffer state
+* @param BuffData the memory of the buffer
+* @param Size the size of the memory of the buffer
+* @param Data a pointer to store the dequeued bytes in, Count bytes
+* @param Count the number of bytes to dequeue
+* @return uint8_t the number of dequeued bytes
+*
+* @see CircBuff_DequeueBulk
+**********************************************************************/
+extern uint8_t
+CircBuff_DequeueBulkSized(CircBuffState_t* Buff, uint8_t* BuffData,
+  uint8_t Size, uint8_t * Data, uint8_t Count)
+{
+  Count = CircBuff_PeekSpanSized(Buff, BuffData, Size, Data, 0, Count);
+
+  //PeekSpan checked the pointers
+  if(Count != 0) CircBuff_SkipSized(Buff, Size, Count);
+
+  return Count;
+}
+
+/*********************************************************************
+* Function : CircBuff_PeekLast()
+*//**
+* \b Description:
+*
+* This function is used to peak the tail of a circuler buffer
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Data a pointer to store the peeked byte in.
+* @return uint8_t 1 if the byte is stored and 0 otherwise.
+*
+* \b Example:
+* @code
+* uint8_t UartBuffer[MAX_UART_BUFF_SIZE];
+* CircBuff_t UartBuff = CircBuff_Create(UartBuffer, MAX_UART_BUFF_SIZE);
+* CircBuff_Enqueue(&UartBuff, 'a'); // now the buffer has 'a'
+* uint8_t x;
+* CircBuff_PeekLast(&UartBuff, &x);
+* @endcode
+*
+* @see CircBuff_PeekLast
+**********************************************************************/
+extern uint8_t 
+CircBuff_PeekLast(CircBuff_t* Buff, uint8_t * Data)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return 0;
+#endif
+
+  return CircBuff_PeekLastSized(&Buff->State, Buff->Data, Buff->Size, Data);
+}
+
+/*********************************************************************
+* Function : CircBuff_PeekLastSized()
+*//**
+* \b Description:
+*
+* This function is used to peak the tail of a circuler buffer whose memory
+* and size are kept by the caller.
+*
+* @param Buff a valid pointer to the circuler buffer state
+* @param BuffData the memory of the buffer
+* @param Size the size of the memory of the buffer
+* @param Data a pointer to store the peeked byte in.
+* @return uint8_t 1 if the byte is stored and 0 otherwise.
+*
+* @see CircBuff_PeekLast
+**********************************************************************/
+extern uint8_t 
+CircBuff_PeekLastSized(CircBuffState_t* Buff, uint8_t* BuffData, uint8_t Size,
+  uint8_t * Data)
+{
+  uint8_t r = 0;
+
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL || BuffData == NULL || Data == NULL) return r;
+#endif
+
+  if(CircBuff_IsEmpty(Buff) != 1)
+    {
+      //just read the rear
+      uint8_t toPeekOn;
+
+      if(Buff->Front == 0) toPeekOn = Size - 1;
+      else toPeekOn = Buff->Front - 1;
+
+      *Data = BuffData[toPeekOn];
+
+      r = 1;
+    }
+
+  return r;
+}
+
+/*********************************************************************
+* Function : CircBuff_PeekAt()
+*//**
+* \b Description:
+*
+* This function is used to read a byte of a circuler buffer without
+* removing it. Offset 0 is the oldest byte, the next one to be dequeued.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Offset the position of the byte from the oldest one
+* @param Data a pointer to store the peeked byte in.
+* @return uint8_t 1 if the byte is stored and 0 if the buffer holds Offset
+* bytes or less.
+*
+* \b Example:
+* @code
+* uint8_t Length;
+* if(CircBuff_PeekAt(&UartBuff, 1, &Length) == 1 &&
+*    CircBuff_Count(&UartBuff) >= Length + 2)
+*   {
+*     //the whole packet (header, length, payload) is received
+*   }
+* @endcode
+*
+* @see CircBuff_PeekSpan
+**********************************************************************/
+extern uint8_t
+CircBuff_PeekAt(CircBuff_t* Buff, uint8_t Offset, uint8_t * Data)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return 0;
+#endif
+
+  return CircBuff_PeekAtSized(&Buff->State, Buff->Data, Buff->Size, Offset, Data);
+}
+
+/*********************************************************************
+* Function : CircBuff_PeekAtSized()
+*//**
+* \b Description:
+*
+* This function is used to read a byte of a circuler buffer whose memory
+* and size are kept by the caller without removing it.
+*
+* @param Buff a valid pointer to the circuler buffer state
+* @param BuffData the memory of the buffer
+* @param Size the size of the memory of the buffer
+* @param Offset the position of the byte from the oldest one
+* @param Data a pointer to store the peeked byte in.
+* @return uint8_t 1 if the byte is stored and 0 if the buffer holds Offset
+* bytes or less.
+*
+* @see CircBuff_PeekAt
+**********************************************************************/
+extern uint8_t
+CircBuff_PeekAtSized(CircBuffState_t* Buff, uint8_t* BuffData, uint8_t Size,
+  uint8_t Offset, uint8_t * Data)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL || BuffData == NULL || Data == NULL) return 0;
+#endif
+
+  uint8_t Rear = Buff->Rear;
+
+  if(Offset >= CircBuff_Distance(Rear, Buff->Front, Size)) return 0;
+
+  //the position is below 2 * Size, one compare wraps it
+  uint16_t Pos = (uint16_t) Rear + Offset;
+  if(Pos >= Size) Pos -= Size;
+
+  *Data = BuffData[Pos];
+
+  return 1;
+}
+
+/*********************************************************************
+* Function : CircBuff_PeekSpan()
+*//**
+* \b Description:
+*
+* This function is used to copy up to Count bytes of a circuler buffer,
+* starting Offset bytes after the oldest one, without removing them. The
+* bytes are copied in at most two runs, one up to the end of the buffer
+* memory and one from its start.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Data a pointer to store the peeked bytes in, Count bytes
+* @param Offset the position of the first byte from the oldest one
+* @param Count the number of bytes to peek
+* @return uint8_t the number of peeked bytes
+*
+* \b Example:
+* @code
+* uint8_t Header[4];
+* if(CircBuff_PeekSpan(&UartBuff, Header, 0, sizeof(Header)) == sizeof(Header))
+*   {
+*     //parse the header, then CircBuff_Skip or dequeue the packet
+*   }
+* @endcode
+*
+* @see CircBuff_PeekAt
+* @see CircBuff_Skip
+**********************************************************************/
+extern uint8_t
+CircBuff_PeekSpan(CircBuff_t* Buff, uint8_t * Data, uint8_t Offset,
+  uint8_t Count)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return 0;
+#endif
+
+  return CircBuff_PeekSpanSized(&Buff->State, Buff->Data, Buff->Size, Data,
+    Offset, Count);
+}
+
+/*********************************************************************
+* Function : CircBuff_PeekSpanSized()
+*//**
+* \b Description:
+*
+* This function is used to copy up to Count bytes of a circuler buffer
+* whose memory and size are kept by the caller, starting Offset bytes after
+* the oldest one, without removing them.
+*
+* @param Buff a valid pointer to the circuler buffer state
+* @param BuffData the memory of the buffer
+* @param Size the size of the memory of the buffer
+* @param Data a pointer to store the peeked bytes in, Count bytes
+* @param Offset the position of the first byte from the oldest one
+* @param Count the number of bytes to peek
+* @return uint8_t the number of peeked bytes
+*
+* @see CircBuff_PeekSpan
+**********************************************************************/
+extern uint8_t
+CircBuff_PeekSpanSized(CircBuffState_t* Buff, uint8_t* BuffData, uint8_t Size,
+  uint8_t * Data, uint8_t Offset, uint8_t Count)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL || BuffData == NULL || Data == NULL) return 0;
+#endif
+
+  uint8_t Rear = Buff->Rear;
+  uint8_t Used = CircBuff_Distance(Rear, Buff->Front, Size);
+
+  if(Offset >= Used) return 0;
+  if(Count > Used - Offset) Count = Used - Offset;
+
+  uint16_t Pos = (uint16_t) Rear + Offset;
+  if(Pos >= Size) Pos -= Size;
+
+  //the run up to the end of the buffer memory, then the wrapped run
+  uint8_t First = Size - (uint8_t) Pos;
+  if(First > Count) First = Count;
+
+  CircBuff_CopyRun(Data, &BuffData[Pos], First);
+  CircBuff_CopyRun(&Data[First], BuffData, (uint8_t) (Count - First));
+
+  return Count;
+}
+
+/*********************************************************************
+* Function : CircBuff_Find()
+*//**
+* \b Description:
+*
+* This function is used to search a circuler buffer for a byte (e.g. a
+* delimiter) without removing anything, starting Offset bytes after the
+* oldest one.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Data the byte to search for
+* @param Offset the position to start the search at from the oldest byte
+* @return uint8_t the position of the first match from the oldest byte,
+* CIRCBUFF_NOT_FOUND if the byte is not found
+*
+* \b Example:
+* @code
+* uint8_t Line[MAX_LINE];
+* uint8_t End = CircBuff_Find(&UartBuff, '\n', 0);
+* if(End != CIRCBUFF_NOT_FOUND && End < sizeof(Line))
+*   {
+*     CircBuff_PeekSpan(&UartBuff, Line, 0, End);
+*     CircBuff_Skip(&UartBuff, End + 1);
+*   }
+* @endcode
+*
+* @see CircBuff_Skip
+**********************************************************************/
+extern uint8_t
+CircBuff_Find(CircBuff_t* Buff, uint8_t Data, uint8_t Offset)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return CIRCBUFF_NOT_FOUND;
+#endif
+
+  return CircBuff_FindSized(&Buff->State, Buff->Data, Buff->Size, Data, Offset);
+}
+
+/*********************************************************************
+* Function : CircBuff_FindSized()
+*//**
+* \b Description:
+*
+* This function is used to search a circuler buffer whose memory and size
+* are kept by the caller for a byte, starting Offset bytes after the
+* oldest one.
+*
+* @param Buff a valid pointer to the circuler buffer state
+* @param BuffData the memory of the buffer
+* @param Size the size of the memory of the buffer
+* @param Data the byte to search for
+* @param Offset the position to start the search at from the oldest byte
+* @return uint8_t the position of the first match from the oldest byte,
+* CIRCBUFF_NOT_FOUND if the byte is not found
+*
+* @see CircBuff_Find
+**********************************************************************/
+extern uint8_t
+CircBuff_FindSized(CircBuffState_t* Buff, uint8_t* BuffData, uint8_t Size,
+  uint8_t Data, uint8_t Offset)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL || BuffData == NULL) return CIRCBUFF_NOT_FOUND;
+#endif
+
+  uint8_t Rear = Buff->Rear;
+  uint8_t Used = CircBuff_Distance(Rear, Buff->Front, Size);
+
+  if(Offset >= Used) return CIRCBUFF_NOT_FOUND;
+
+  uint16_t Pos = (uint16_t) Rear + Offset;
+  if(Pos >= Size) Pos -= Size;
+
+  //the run up to the end of the buffer memory, then the wrapped run
+  uint8_t Count = (uint8_t) (Used - Offset);
+  uint8_t First = Size - (uint8_t) Pos;
+  if(First > Count) First = Count;
+
+  uint8_t Found = CircBuff_FindRun(&BuffData[Pos], First, Data);
+  if(Found < First) return (uint8_t) (Offset + Found);
+
+  Found = CircBuff_FindRun(BuffData, (uint8_t) (Count - First), Data);
+  if(Found < Count - First) return (uint8_t) (Offset + First + Found);
+
+  return CIRCBUFF_NOT_FOUND;
+}
+
+/*********************************************************************
+* Function : CircBuff_Skip()
+*//**
+* \b Description:
+*
+* This function is used to discard up to Count of the oldest bytes of a
+* circuler buffer, e.g. a packet already read with CircBuff_PeekSpan.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Count the number of bytes to discard
+* @return uint8_t the number of discarded bytes
+*
+* @see CircBuff_PeekSpan
+* @see CircBuff_Find
+**********************************************************************/
+extern uint8_t
+CircBuff_Skip(CircBuff_t* Buff, uint8_t Count)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return 0;
+#endif
+
+  return CircBuff_SkipSized(&Buff->State, Buff->Size, Count);
+}
+
+/*********************************************************************
+* Function : CircBuff_SkipSized()
+*//**
+* \b Description:
+*
+* This function is used to discard up to Count of the oldest bytes of a
+* circuler buffer whose size is kept by the caller.
+*
+* @param Buff a valid pointer to the circuler buffer state
+* @param Size the size of the memory of the buffer
+* @param Count the number of bytes to discard
+* @return uint8_t the number of discarded bytes
+*
+* @see CircBuff_Skip
+**********************************************************************/
+extern uint8_t
+CircBuff_SkipSized(CircBuffState_t* Buff, uint8_t Size, uint8_t Count)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return 0;
+#endif
+
+  uint8_t Rear = Buff->Rear;
+  uint8_t Used = CircBuff_Distance(Rear, Buff->Front, Size);
+
+  if(Count > Used) Count = Used;
+
+  uint16_t Pos = (uint16_t) Rear + Count;
+  if(Pos >= Size) Pos -= Size;
+
+  Buff->Rear = (uint8_t) Pos;
+
+  return Count;
+}
+
+/*********************************************************************
+* Function : CircBuff_ReadRegion()
+*//**
+* \b Description:
+*
+* This function is used to get the contiguous run of stored bytes that
+* starts at the oldest one, so a consumer (e.g. a write(2) to a file
+* descriptor) can take it in place. The bytes are removed by CircBuff_Skip
+* once they are consumed. The rest of the stored bytes, if any, start at
+* the beginning of the buffer memory.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Data a pointer to store the address of the run in
+* @return uint8_t the number of bytes in the run, 0 if the buffer is empty
+*
+* \b Example:
+* @code
+* uint8_t* Run;
+* uint8_t Length = CircBuff_ReadRegion(&TxBuff, &Run);
+* ssize_t n = write(Fd, Run, Length);
+* if(n > 0) CircBuff_Skip(&TxBuff, (uint8_t) n);
+* @endcode
+*
+* @see CircBuff_Skip
+* @see CircBuff_WriteRegion
+**********************************************************************/
+extern uint8_t
+CircBuff_ReadRegion(CircBuff_t* Buff, uint8_t ** Data)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL || Data == NULL) return 0;
+#endif
+
+  uint8_t Rear = Buff->State.Rear;
+  uint8_t Used = CircBuff_Distance(Rear, Buff->State.Front, Buff->Size);
+  uint8_t Run = Buff->Size - Rear;
+
+  *Data = &Buff->Data[Rear];
+
+  return (Used < Run) ? Used : Run;
+}
+
+/*********************************************************************
+* Function : CircBuff_WriteRegion()
+*//**
+* \b Description:
+*
+* This function is used to get the contiguous run of free slots that
+* starts after the newest byte, so a producer (e.g. a read(2) from a file
+* descriptor) can fill it in place. The bytes are stored by
+* CircBuff_CommitWrite once they are written. The overflow policy is not
+* applied, the run is empty when the buffer is full.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Data a pointer to store the address of the run in
+* @return uint8_t the number of free slots in the run, 0 if the buffer is
+* full
+*
+* \b Example:
+* @code
+* uint8_t* Run;
+* uint8_t Length = CircBuff_WriteRegion(&RxBuff, &Run);
+* ssize_t n = read(Fd, Run, Length);
+* if(n > 0) CircBuff_CommitWrite(&RxBuff, (uint8_t) n);
+* @endcode
+*
+* @see CircBuff_CommitWrite
+* @see CircBuff_ReadRegion
+**********************************************************************/
+extern uint8_t
+CircBuff_WriteRegion(CircBuff_t* Buff, uint8_t ** Data)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL || Data == NULL) return 0;
+#endif
+
+  uint8_t Front = Buff->State.Front;
+  uint8_t Free = (uint8_t) (Buff->Size - 1 -
+    CircBuff_Distance(Buff->State.Rear, Front, Buff->Size));
+  uint8_t Run = Buff->Size - Front;
+
+  *Data = &Buff->Data[Front];
+
+  return (Free < Run) ? Free : Run;
+}
+
+/*********************************************************************
+* Function : CircBuff_CommitWrite()
+*//**
+* \b Description:
+*
+* This function is used to store the bytes written in place after the
+* newest one, in the run given by CircBuff_WriteRegion. The Front is moved
+* once.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Count the number of written bytes
+* @return uint8_t the number of stored bytes, at most the free slots
+*
+* @see CircBuff_WriteRegion
+**********************************************************************/
+extern uint8_t
+CircBuff_CommitWrite(CircBuff_t* Buff, uint8_t Count)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return 0;
+#endif
+
+  uint8_t Front = Buff->State.Front;
+  uint8_t Free = (uint8_t) (Buff->Size - 1 -
+    CircBuff_Distance(Buff->State.Rear, Front, Buff->Size));
+
+  if(Count > Free) Count = Free;
+
+  uint16_t Pos = (uint16_t) Front + Count;
+  if(Pos >= Buff->Size) Pos -= Buff->Size;
+
+  Buff->State.Front = (uint8_t) Pos;
+
+  return Count;
+}
+
+/*********************************************************************
+* Function : CircBuff_ReadRegions()
+*//**
+* \b Description:
+*
+* This function is used to get all the stored bytes as two contiguous runs,
+* from the oldest one to the end of the buffer memory and from its start,
+* so a consumer can take them with a single writev(2). The second run is
+* empty when the bytes don't wrap. The bytes are removed by CircBuff_Skip
+* once they are consumed.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Regions a pointer to store the two runs in
+* @return uint8_t the number of stored bytes, the sum of the run lengths
+*
+* \b Example:
+* @code
+* CircBuffRegion_t Runs[2];
+* uint8_t Length = CircBuff_ReadRegions(&TxBuff, Runs);
+* struct iovec Vectors[2] = { { Runs[0].Data, Runs[0].Length },
+*                             { Runs[1].Data, Runs[1].Length } };
+* ssize_t n = writev(Fd, Vectors, 2);
+* if(n > 0) CircBuff_Skip(&TxBuff, (uint8_t) n);
+* @endcode
+*
+* @see CircBuff_ReadRegion
+* @see CircBuff_WriteRegions
+**********************************************************************/
+extern uint8_t
+CircBuff_ReadRegions(CircBuff_t* Buff, CircBuffRegion_t Regions[2])
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL || Regions == NULL) return 0;
+#endif
+
+  uint8_t Used = CircBuff_Distance(Buff->State.Rear, Buff->State.Front, Buff->Size);
+
+  Regions[0].Length = CircBuff_ReadRegion(Buff, &Regions[0].Data);
+  Regions[1].Data = Buff->Data;
+  Regions[1].Length = (uint8_t) (Used - Regions[0].Length);
+
+  return Used;
+}
+
+/*********************************************************************
+* Function : CircBuff_WriteRegions()
+*//**
+* \b Description:
+*
+* This function is used to get all the free slots as two contiguous runs,
+* from the one after the newest byte to the end of the buffer memory and
+* from its start, so a producer can fill them with a single readv(2). The
+* second run is empty when the free slots don't wrap. The bytes are stored
+* by CircBuff_CommitWrite once they are written.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @param Regions a pointer to store the two runs in
+* @return uint8_t the number of free slots, the sum of the run lengths
+*
+* @see CircBuff_WriteRegion
+* @see CircBuff_CommitWrite
+**********************************************************************/
+extern uint8_t
+CircBuff_WriteRegions(CircBuff_t* Buff, CircBuffRegion_t Regions[2])
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL || Regions == NULL) return 0;
+#endif
+
+  uint8_t Free = (uint8_t) (Buff->Size - 1 -
+    CircBuff_Distance(Buff->State.Rear, Buff->State.Front, Buff->Size));
+
+  Regions[0].Length = CircBuff_WriteRegion(Buff, &Regions[0].Data);
+  Regions[1].Data = Buff->Data;
+  Regions[1].Length = (uint8_t) (Free - Regions[0].Length);
+
+  return Free;
+}
+
+/*********************************************************************
+* Function : CircBuff_Count()
+*//**
+* \b Description:
+*
+* This function is used to get the number of bytes stored in a circuler
+* buffer
+*
+* @param Buff a valid pointer to the circuler buffer
+* @return uint8_t the number of bytes in the buffer, 0 if Buff is invalid
+*
+* \b Example:
+* @code
+* uint8_t UartBuffer[MAX_UART_BUFF_SIZE];
+* CircBuff_t UartBuff = CircBuff_Create(UartBuffer, MAX_UART_BUFF_SIZE);
+* CircBuff_Enqueue(&UartBuff, 'a');
+* uint8_t n = CircBuff_Count(&UartBuff); // n is 1
+* @endcode
+*
+* @see CircBuff_Create
+**********************************************************************/
+extern uint8_t
+CircBuff_Count(CircBuff_t* Buff)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return 0;
+#endif
+
+  return CircBuff_CountSized(&Buff->State, Buff->Size);
+}
+
+/*********************************************************************
+* Function : CircBuff_GetLost()
+*//**
+* \b Description:
+*
+* This function is used to get the number of bytes overwritten (with
+* CIRCBUFF_OVERWRITE_OLDEST) or discarded (with CIRCBUFF_REPORT) because
+* the buffer was full. It's cleared by CircBuff_Reset.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @return uint16_t the number of lost bytes, 0 if Buff is invalid
+*
+* @see CircBuff_CreatePolicy
+**********************************************************************/
+extern uint16_t
+CircBuff_GetLost(CircBuff_t* Buff)
+{
+#if (CIRCBUFF_DEV_ERROR_DETECT == 1)
+  if(Buff == NULL) return 0;
+#endif
+
+  return Buff->State.Lost;
+}
+
+/************************End Of File ******************************/
\ No newline at end of file
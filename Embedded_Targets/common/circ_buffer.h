@@ -0,0 +1,294 @@
+/**
+ * @file circ_buffer.h
+ * @author Mohamed Hassanin 
+ * @brief A circular buffer/queue module. 
+ * Note: one space is wasted in the buffer to know if it's empty
+ * @version 0.1
+ * @date 2021-02-15
+ * 
+ * @copyright Copyright (c) 2021
+ * 
+ */
+
+#ifndef CIRC_BUFFER_H
+#define CIRC_BUFFER_H
+
+/*******************************************************************
+ * Includes
+*******************************************************************/
+#include <inttypes.h>
+/*******************************************************************
+ * Preprocessor constants
+*******************************************************************/
+#ifndef CIRCBUFF_DEV_ERROR_DETECT
+#define CIRCBUFF_DEV_ERROR_DETECT 1 /**< 1 to check the pointers passed to the
+buffer functions, 0 to remove the checks in release builds */
+#endif
+
+#define CIRCBUFF_KERNEL_SCALAR 0 /**< byte loops */
+#define CIRCBUFF_KERNEL_SWAR 1 /**< machine word loops, on little endian hosts
+with a word of 32 bits or more */
+#define CIRCBUFF_KERNEL_SSE2 2 /**< 16 byte vector loops, then word loops */
+
+#ifndef CIRCBUFF_KERNEL
+#if defined(__GNUC__) && defined(__SSE2__)
+#define CIRCBUFF_KERNEL CIRCBUFF_KERNEL_SSE2
+#elif defined(__GNUC__) && (UINTPTR_MAX > 0xFFFF) && \
+  (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define CIRCBUFF_KERNEL CIRCBUFF_KERNEL_SWAR
+#else
+#define CIRCBUFF_KERNEL CIRCBUFF_KERNEL_SCALAR /**< the kernels of the bulk
+copies and the byte search, selected from the target unless defined */
+#endif
+#endif
+
+#define CIRCBUFF_NOT_FOUND 0xFF /**< the offset returned by CircBuff_Find when
+the byte is not in the buffer, a buffer holds at most 254 bytes */
+/*******************************************************************
+ * Preprocessor macros
+*******************************************************************/
+#if defined(__GNUC__)
+/**
+ * Reads the index written by the other side of a single producer single
+ * consumer buffer, the data it publishes is read after it.
+ */
+#define CIRCBUFF_LOAD_ACQUIRE(Index) __atomic_load_n(&(Index), __ATOMIC_ACQUIRE)
+/**
+ * Writes the index read by the other side of a single producer single
+ * consumer buffer, the data it publishes is written before it.
+ */
+#define CIRCBUFF_STORE_RELEASE(Index, Value) \
+  __atomic_store_n(&(Index), (Value), __ATOMIC_RELEASE)
+#else
+#define CIRCBUFF_LOAD_ACQUIRE(Index) (*(volatile uint8_t*) &(Index))
+#define CIRCBUFF_STORE_RELEASE(Index, Value) \
+  (*(volatile uint8_t*) &(Index) = (Value))
+#endif
+/*******************************************************************
+ * typedefs
+*******************************************************************/
+/**
+ * @brief What to do with a byte enqueued into a full buffer.
+ * 
+ */
+typedef enum {
+    CIRCBUFF_DROP_NEW, /*< the new byte is discarded */
+    CIRCBUFF_OVERWRITE_OLDEST, /*< the oldest byte is overwritten and counted */
+    CIRCBUFF_REPORT, /*< the new byte is discarded and counted */
+}CircBuffPolicy_t;
+
+/**
+ * @brief The state of a circular buffer without its memory and size. A
+ * module owning several buffers of the same constant size keeps only this
+ * per buffer and passes the memory and the size to the *Sized functions.
+ * 
+ */
+typedef struct CircBuffState {
+    uint8_t Rear; /*< the Rear of the queue */
+    uint8_t Front; /*< the Front of the queue */
+    uint8_t Policy; /*< the overflow policy (CircBuffPolicy_t) */
+    uint16_t Lost; /*< the number of overwritten or reported bytes */
+}CircBuffState_t;
+
+/**
+ * @brief Circular Buffer structure to hold the information of it.
+ * 
+ */
+typedef struct CircBuff {
+    CircBuffState_t State; /*< the indexes, policy and lost counter */
+    uint8_t Size; /*< the Size of the buffer */
+    uint8_t* Data; /*< a pointer to the buffer Data */
+}CircBuff_t;
+
+/**
+ * @brief A contiguous run of a circular buffer, stored bytes or free slots.
+ * It maps to a struct iovec for readv(2) and writev(2).
+ * 
+ */
+typedef struct CircBuffRegion {
+    uint8_t* Data; /*< the first byte of the run */
+    uint8_t Length; /*< the number of bytes in the run */
+}CircBuffRegion_t;
+/*******************************************************************
+ * Prototypes
+*******************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern CircBuff_t CircBuff_Create(uint8_t* BuffData, uint8_t Size);
+extern CircBuff_t CircBuff_CreatePolicy(uint8_t* BuffData, uint8_t Size,
+  CircBuffPolicy_t Policy);
+extern void CircBuff_Reset(CircBuff_t* Buff);
+extern uint8_t CircBuff_Dequeue(CircBuff_t* Buff, uint8_t * Data);
+extern uint8_t CircBuff_Enqueue(CircBuff_t* Buff, uint8_t Data);
+extern uint8_t CircBuff_EnqueueBulk(CircBuff_t* Buff, const uint8_t * Data,
+  uint8_t Count);
+extern uint8_t CircBuff_DequeueBulk(CircBuff_t* Buff, uint8_t * Data, uint8_t Count);
+extern uint8_t CircBuff_PeekLast(CircBuff_t* Buff, uint8_t * Data);
+extern uint8_t CircBuff_PeekAt(CircBuff_t* Buff, uint8_t Offset, uint8_t * Data);
+extern uint8_t CircBuff_PeekSpan(CircBuff_t* Buff, uint8_t * Data, uint8_t Offset,
+  uint8_t Count);
+extern uint8_t CircBuff_Find(CircBuff_t* Buff, uint8_t Data, uint8_t Offset);
+extern uint8_t CircBuff_Skip(CircBuff_t* Buff, uint8_t Count);
+extern uint8_t CircBuff_ReadRegion(CircBuff_t* Buff, uint8_t ** Data);
+extern uint8_t CircBuff_WriteRegion(CircBuff_t* Buff, uint8_t ** Data);
+extern uint8_t CircBuff_CommitWrite(CircBuff_t* Buff, uint8_t Count);
+extern uint8_t CircBuff_ReadRegions(CircBuff_t* Buff, CircBuffRegion_t Regions[2]);
+extern uint8_t CircBuff_WriteRegions(CircBuff_t* Buff, CircBuffRegion_t Regions[2]);
+extern uint8_t CircBuff_Count(CircBuff_t* Buff);
+extern uint16_t CircBuff_GetLost(CircBuff_t* Buff);
+
+extern CircBuffState_t CircBuff_CreateState(CircBuffPolicy_t Policy);
+extern uint8_t CircBuff_EnqueueBulkSized(CircBuffState_t* Buff, uint8_t* BuffData,
+  uint8_t Size, const uint8_t * Data, uint8_t Count);
+extern uint8_t CircBuff_DequeueBulkSized(CircBuffState_t* Buff, uint8_t* BuffData,
+  uint8_t Size, uint8_t * Data, uint8_t Count);
+extern uint8_t CircBuff_PeekLastSized(CircBuffState_t* Buff, uint8_t* BuffData,
+  uint8_t Size, uint8_t * Data);
+extern uint8_t CircBuff_PeekAtSized(CircBuffState_t* Buff, uint8_t* BuffData,
+  uint8_t Size, uint8_t Offset, uint8_t * Data);
+extern uint8_t CircBuff_PeekSpanSized(CircBuffState_t* Buff, uint8_t* BuffData,
+  uint8_t Size, uint8_t * Data, uint8_t Offset, uint8_t Count);
+extern uint8_t CircBuff_FindSized(CircBuffState_t* Buff, uint8_t* BuffData,
+  uint8_t Size, uint8_t Data, uint8_t Offset);
+extern uint8_t CircBuff_SkipSized(CircBuffState_t* Buff, uint8_t Size, uint8_t Count);
+
+/*******************************************************************
+ * Inline functions
+*******************************************************************/
+/**
+ * @brief The index after Index in a buffer of Size slots. It's the index
+ * logic shared by all the buffers, the wrap is a compare instead of a
+ * modulo.
+ * 
+ * @param Index a Rear or a Front
+ * @param Size the number of slots
+ * @return uint8_t the next index
+ */
+static inline uint8_t
+CircBuff_Next(uint8_t Index, uint8_t Size)
+{
+  Index++;
+
+  return (Index == Size) ? 0 : Index;
+}
+
+/**
+ * @brief The number of slots from Rear to Front in a buffer of Size slots,
+ * i.e. the number of stored elements.
+ * 
+ * @param Rear the Rear of the buffer
+ * @param Front the Front of the buffer
+ * @param Size the number of slots
+ * @return uint8_t the number of stored elements
+ */
+static inline uint8_t
+CircBuff_Distance(uint8_t Rear, uint8_t Front, uint8_t Size)
+{
+  return (Front >= Rear) ? (uint8_t) (Front - Rear) : (uint8_t) (Size - Rear + Front);
+}
+
+/**
+ * @brief Header-only fast path of CircBuff_Enqueue for a buffer whose memory
+ * and size are known by the caller. It does no pointer checks and wraps the
+ * index with a compare instead of a modulo, when Size is a constant the
+ * compare is done against an immediate and no size is loaded.
+ * When the buffer is full the buffer policy is applied, note that
+ * CIRCBUFF_OVERWRITE_OLDEST moves the Rear so the producer and the
+ * consumer must not run concurrently.
+ * 
+ * @param Buff a valid pointer to the circuler buffer state
+ * @param BuffData the memory of the buffer
+ * @param Size the size of the memory of the buffer
+ * @param Data a byte to add to the queue.
+ * @return uint8_t 1 if the byte is stored and 0 otherwise.
+ */
+static inline uint8_t
+CircBuff_EnqueueSized(CircBuffState_t* Buff, uint8_t* BuffData, uint8_t Size,
+  uint8_t Data)
+{
+  uint8_t Next = CircBuff_Next(Buff->Front, Size);
+
+  if(Next == Buff->Rear)
+    {
+      //full, apply the overflow policy
+      if(Buff->Policy == CIRCBUFF_DROP_NEW) return 0;
+
+      Buff->Lost++;
+      if(Buff->Policy == CIRCBUFF_REPORT) return 0;
+
+      Buff->Rear = CircBuff_Next(Next, Size);
+    }
+
+  BuffData[Buff->Front] = Data;
+  Buff->Front = Next;
+
+  return 1;
+}
+
+/**
+ * @brief Header-only fast path of CircBuff_Dequeue for a buffer whose memory
+ * and size are known by the caller. It does no pointer checks and wraps the
+ * index with a compare instead of a modulo.
+ * 
+ * @param Buff a valid pointer to the circuler buffer state
+ * @param BuffData the memory of the buffer
+ * @param Size the size of the memory of the buffer
+ * @param Data a valid pointer to store the dequeued Data in.
+ * @return uint8_t 1 if there's a valid Data returned, 0 otherwise
+ */
+static inline uint8_t
+CircBuff_DequeueSized(CircBuffState_t* Buff, uint8_t* BuffData, uint8_t Size,
+  uint8_t * Data)
+{
+  uint8_t Rear = Buff->Rear;
+
+  if(Rear == Buff->Front) return 0;
+
+  *Data = BuffData[Rear];
+  Buff->Rear = CircBuff_Next(Rear, Size);
+
+  return 1;
+}
+
+/**
+ * @brief Header-only count of the bytes stored in a buffer whose size is
+ * known by the caller.
+ * 
+ * @param Buff a valid pointer to the circuler buffer state
+ * @param Size the size of the memory of the buffer
+ * @return uint8_t the number of bytes in the buffer
+ */
+static inline uint8_t
+CircBuff_CountSized(const CircBuffState_t* Buff, uint8_t Size)
+{
+  return CircBuff_Distance(Buff->Rear, Buff->Front, Size);
+}
+
+/**
+ * @brief Header-only fast path of CircBuff_Enqueue.
+ * @see CircBuff_EnqueueSized
+ */
+static inline uint8_t
+CircBuff_EnqueueInline(CircBuff_t* Buff, uint8_t Data)
+{
+  return CircBuff_EnqueueSized(&Buff->State, Buff->Data, Buff->Size, Data);
+}
+
+/**
+ * @brief Header-only fast path of CircBuff_Dequeue.
+ * @see CircBuff_DequeueSized
+ */
+static inline uint8_t
+CircBuff_DequeueInline(CircBuff_t* Buff, uint8_t * Data)
+{
+  return CircBuff_DequeueSized(&Buff->State, Buff->Data, Buff->Size, Data);
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* end CIRC_BUFFER_H */
+/************************End Of File ******************************/
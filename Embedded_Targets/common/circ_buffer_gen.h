@@ -0,0 +1,177 @@
+/**
+ * @file circ_buffer_gen.h
+ * @author Mohamed Hassanin
+ * @brief A generator of circular buffers/queues of any element type, e.g.
+ * messages or pointers to pool allocated frames. It shares the index logic
+ * of circ_buffer.h.
+ * Note: one space is wasted in the buffer to know if it's empty
+ * @version 0.1
+ * @date 2021-02-15
+ *
+ * @copyright Copyright (c) 2021
+ *
+ */
+
+#ifndef CIRC_BUFFER_GEN_H
+#define CIRC_BUFFER_GEN_H
+
+/*******************************************************************
+ * Includes
+*******************************************************************/
+#include <inttypes.h>
+#include "circ_buffer.h"
+/*******************************************************************
+ * Preprocessor macros
+*******************************************************************/
+/**
+ * @brief Generates the type Name_t, a circular buffer of Size - 1 elements of
+ * Type, and its functions:
+ *
+ * - Name_Reset(Buff): empties the buffer
+ * - Name_Enqueue(Buff, Data): adds an element, 1 if stored 0 if full
+ * - Name_Dequeue(Buff, Data): removes the oldest element, 1 if removed 0 if
+ *   empty
+ * - Name_EnqueueBulk(Buff, Data, Count): adds up to Count elements, returns
+ *   the number of stored elements
+ * - Name_DequeueBulk(Buff, Data, Count): removes up to Count elements,
+ *   returns the number of removed elements
+ * - Name_Count(Buff): the number of stored elements
+ * - Name_EnqueueOverwrite(Buff, Data): adds an element, overwriting the
+ *   oldest one if full, 1 if an element was overwritten 0 otherwise
+ *
+ * One producer and one consumer (e.g. an ISR and a task) may use the buffer
+ * concurrently without locking: each side writes its own index only, and
+ * publishes it after the data (CIRCBUFF_STORE_RELEASE). The bulk functions
+ * publish once per call. Name_EnqueueOverwrite moves the Rear so it's not
+ * safe with a concurrent consumer, like CIRCBUFF_OVERWRITE_OLDEST.
+ *
+ * The functions are static inline so the generator can be used in a header
+ * or in the translation unit that owns the buffer.
+ *
+ * \b Example:
+ * @code
+ * CIRCBUFF_GENERATE(FrameQueue, Frame_t*, 8)
+ *
+ * static FrameQueue_t RxFrames;
+ *
+ * FrameQueue_Enqueue(&RxFrames, Frame); // in the ISR
+ * if(FrameQueue_Dequeue(&RxFrames, &Frame) == 1) Process(Frame); // in a task
+ * @endcode
+ *
+ * @param Name the prefix of the generated type and functions
+ * @param Type the element type
+ * @param Size the number of slots, 2 to 255
+ */
+#define CIRCBUFF_GENERATE(Name, Type, Size)                                   \
+                                                                              \
+typedef struct                                                                \
+{                                                                             \
+  Type Data[Size]; /*< the buffer Data */                                     \
+  uint8_t Rear; /*< the Rear of the queue, written by the consumer */         \
+  uint8_t Front; /*< the Front of the queue, written by the producer */       \
+} Name##_t;                                                                   \
+                                                                              \
+typedef char Name##_SizeCheck_t[((Size) >= 2 && (Size) <= 255) ? 1 : -1];     \
+                                                                              \
+static inline void                                                            \
+Name##_Reset(Name##_t* Buff)                                                  \
+{                                                                             \
+  Buff->Rear = 0;                                                             \
+  Buff->Front = 0;                                                            \
+}                                                                             \
+                                                                              \
+static inline uint8_t                                                         \
+Name##_Enqueue(Name##_t* Buff, Type Data)                                     \
+{                                                                             \
+  uint8_t Front = Buff->Front;                                                \
+  uint8_t Next = CircBuff_Next(Front, (Size));                                \
+                                                                              \
+  if(Next == CIRCBUFF_LOAD_ACQUIRE(Buff->Rear)) return 0;                     \
+                                                                              \
+  Buff->Data[Front] = Data;                                                   \
+  CIRCBUFF_STORE_RELEASE(Buff->Front, Next);                                  \
+                                                                              \
+  return 1;                                                                   \
+}                                                                             \
+                                                                              \
+static inline uint8_t                                                         \
+Name##_Dequeue(Name##_t* Buff, Type* Data)                                    \
+{                                                                             \
+  uint8_t Rear = Buff->Rear;                                                  \
+                                                                              \
+  if(Rear == CIRCBUFF_LOAD_ACQUIRE(Buff->Front)) return 0;                    \
+                                                                              \
+  *Data = Buff->Data[Rear];                                                   \
+  CIRCBUFF_STORE_RELEASE(Buff->Rear, CircBuff_Next(Rear, (Size)));            \
+                                                                              \
+  return 1;                                                                   \
+}                                                                             \
+                                                                              \
+static inline uint8_t                                                         \
+Name##_EnqueueBulk(Name##_t* Buff, Type const* Data, uint8_t Count)           \
+{                                                                             \
+  uint8_t Front = Buff->Front;                                                \
+  uint8_t Free = (uint8_t) ((Size) - 1 -                                      \
+    CircBuff_Distance(CIRCBUFF_LOAD_ACQUIRE(Buff->Rear), Front, (Size)));     \
+                                                                              \
+  if(Count > Free) Count = Free;                                              \
+                                                                              \
+  for(uint8_t i = 0; i < Count; i++)                                          \
+    {                                                                         \
+      Buff->Data[Front] = Data[i];                                            \
+      Front = CircBuff_Next(Front, (Size));                                   \
+    }                                                                         \
+                                                                              \
+  CIRCBUFF_STORE_RELEASE(Buff->Front, Front);                                 \
+                                                                              \
+  return Count;                                                               \
+}                                                                             \
+                                                                              \
+static inline uint8_t                                                         \
+Name##_DequeueBulk(Name##_t* Buff, Type* Data, uint8_t Count)                 \
+{                                                                             \
+  uint8_t Rear = Buff->Rear;                                                  \
+  uint8_t Used =                                                              \
+    CircBuff_Distance(Rear, CIRCBUFF_LOAD_ACQUIRE(Buff->Front), (Size));      \
+                                                                              \
+  if(Count > Used) Count = Used;                                              \
+                                                                              \
+  for(uint8_t i = 0; i < Count; i++)                                          \
+    {                                                                         \
+      Data[i] = Buff->Data[Rear];                                             \
+      Rear = CircBuff_Next(Rear, (Size));                                     \
+    }                                                                         \
+                                                                              \
+  CIRCBUFF_STORE_RELEASE(Buff->Rear, Rear);                                   \
+                                                                              \
+  return Count;                                                               \
+}                                                                             \
+                                                                              \
+static inline uint8_t                                                         \
+Name##_Count(Name##_t* Buff)                                                  \
+{                                                                             \
+  return CircBuff_Distance(CIRCBUFF_LOAD_ACQUIRE(Buff->Rear),                 \
+    CIRCBUFF_LOAD_ACQUIRE(Buff->Front), (Size));                              \
+}                                                                             \
+                                                                              \
+static inline uint8_t                                                         \
+Name##_EnqueueOverwrite(Name##_t* Buff, Type Data)                            \
+{                                                                             \
+  uint8_t Front = Buff->Front;                                                \
+  uint8_t Next = CircBuff_Next(Front, (Size));                                \
+  uint8_t Overwritten = 0;                                                    \
+                                                                              \
+  if(Next == Buff->Rear)                                                      \
+    {                                                                         \
+      Buff->Rear = CircBuff_Next(Next, (Size));                               \
+      Overwritten = 1;                                                        \
+    }                                                                         \
+                                                                              \
+  Buff->Data[Front] = Data;                                                   \
+  CIRCBUFF_STORE_RELEASE(Buff->Front, Next);                                  \
+                                                                              \
+  return Overwritten;                                                         \
+}
+
+#endif /* end CIRC_BUFFER_GEN_H */
+/************************End Of File ******************************/
@@ -0,0 +1,343 @@
+/**
+ * @file det.c
+ * @author Mohamed Hassanin
+ * @brief a default error tracer for error handling
+ * @version 0.1
+ * @date 2021-03-12
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "det.h"
+#include "circ_buffer_gen.h"
+/******************************************************************************
+ * typedefs
+ ******************************************************************************/
+/**
+ * @brief The error trace ring, DetTraceRing_t and its functions
+ */
+CIRCBUFF_GENERATE(DetTraceRing, DetTrace_t, DET_TRACE_SIZE)
+
+/**
+ * @brief The last record time of an error, for the rate limiting
+ */
+typedef struct
+{
+  uint32_t Timestamp; /**< the tick the error was last recorded at, 0 if the
+  slot is free */
+  uint16_t ModuleId; /**< the module of the error */
+  uint8_t InstanceId; /**< the module instance of the error */
+  uint8_t ApiId; /**< the service of the error */
+  uint8_t ErrorId; /**< the error */
+} DetRateLimit_t;
+/******************************************************************************
+* Module Variable Definitions
+ ******************************************************************************/
+/**
+ * brief the error trace, it drops the new records when it's full so the
+ * reader (e.g. a task) and the writer (e.g. an interrupt) each write their own
+ * index only
+ */
+static DetTraceRing_t DetTrace;
+
+/**
+ * brief the number of records dropped because the trace was full
+ */
+static uint16_t DetTraceLost;
+
+/**
+ * brief the number of reports not recorded due to the rate limiting
+ */
+static uint16_t DetTraceSuppressed;
+
+/**
+ * brief the module table, 0x00 until Det_Init so every error is only traced
+ */
+static const DetModuleConfig_t * DetConfig;
+
+/**
+ * brief the source of the timestamps, 0x00 if none
+ */
+static DetTickSource_t DetTickSource;
+
+#if (DET_RATE_LIMIT_TICKS != 0)
+/**
+ * brief the last record time of the recently reported errors
+ */
+static DetRateLimit_t DetRateLimit[DET_RATE_LIMIT_SLOTS];
+#endif
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static void Det_DefaultHandler(void);
+static uint8_t Det_RateLimited(uint16_t ModuleId, uint8_t InstanceId,
+  uint8_t ApiId, uint8_t ErrorId, uint32_t Timestamp);
+static void Det_TraceWrite(uint16_t ModuleId, uint8_t InstanceId, uint8_t ApiId,
+  uint8_t ErrorId, uint32_t Timestamp);
+/******************************************************************************
+ * Function definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Det_Init()
+*//**
+* \b Description:
+* This function is used to set the module table that maps the module and error
+* ids of a report to its severity and handler. <br>
+* PRE-CONDITION: The module table is indexed by the module id and every error
+* table by the error id <br>
+* @param Config a pointer to the module table
+* @return void
+*
+* \b Example:
+* @code
+* Det_Init(Det_GetConfig());
+* @endcode
+* @see Det_GetConfig
+* @see Det_ReportError
+*******************************************************************************/
+extern void
+Det_Init(const DetModuleConfig_t * const Config)
+{
+  DetConfig = Config;
+}
+
+/******************************************************************************
+* Function : Det_ReportError()
+*//**
+* \b Description:
+* This function is used to report an error. The severity and the handler of
+* the error are looked up in the module table, an error without a row (or
+* reported before Det_Init) is only traced. A traced error is recorded with a
+* timestamp in the error trace unless the same error of the same instance was
+* recorded less than DET_RATE_LIMIT_TICKS ago. <br>
+* @param ModuleId the module that reports the error
+* @param InstanceId the module instance (e.g. the Uart Id)
+* @param ApiId the service the error is reported from
+* @param ErrorId the error
+* @return void
+*
+* @see Det_Init
+* @see Det_TraceRead
+*******************************************************************************/
+extern void 
+Det_ReportError(
+  uint16_t ModuleId,
+  uint8_t InstanceId, 
+  uint8_t ApiId, 
+  uint8_t ErrorId)
+{
+  const DetErrorConfig_t * Error = 0x00;
+  DetSeverity_t Severity = DET_SEVERITY_TRACE;
+  uint32_t Timestamp;
+
+  if(DetConfig != 0x00 && ModuleId < DET_MODULE_COUNT &&
+     ErrorId < DetConfig[ModuleId].ErrorCount)
+    {
+      Error = &DetConfig[ModuleId].Errors[ErrorId];
+      Severity = Error->Severity;
+    }
+
+  if(Severity == DET_SEVERITY_IGNORE) return;
+
+  Timestamp = (DetTickSource != 0x00) ? DetTickSource() : 0;
+
+  if(Det_RateLimited(ModuleId, InstanceId, ApiId, ErrorId, Timestamp) == 1)
+    {
+      DetTraceSuppressed++;
+    }
+  else
+    {
+      Det_TraceWrite(ModuleId, InstanceId, ApiId, ErrorId, Timestamp);
+    }
+
+  if(Severity >= DET_SEVERITY_HANDLE && Error->Handler != 0x00)
+    {
+      Error->Handler(InstanceId, ApiId, ErrorId);
+    }
+
+  if(Severity == DET_SEVERITY_HALT)
+    {
+      Det_DefaultHandler();
+    }
+}
+
+/******************************************************************************
+* Function : Det_SetTickSource()
+*//**
+* \b Description:
+* This function is used to set the source of the timestamps of the error
+* records, e.g. the scheduler tick counter. Without a source the records are
+* timestamped 0 and the rate limiting is disabled. <br>
+* @param TickSource a function returning the current tick, 0x00 for none
+* @return void
+*
+* \b Example:
+* @code
+* Det_SetTickSource(Scheduler_GetTick);
+* @endcode
+*******************************************************************************/
+extern void
+Det_SetTickSource(DetTickSource_t TickSource)
+{
+  DetTickSource = TickSource;
+}
+
+/******************************************************************************
+* Function : Det_TraceRead()
+*//**
+* \b Description:
+* This function is used to read (and remove) the oldest record of the error
+* trace. <br>
+* @param Trace a pointer to store the record in
+* @return uint8_t 1 if a record is read, 0 if the trace is empty
+*
+* \b Example:
+* @code
+* DetTrace_t Trace;
+* while(Det_TraceRead(&Trace) == 1)
+*   {
+*     Log(&Trace);
+*   }
+* @endcode
+* @see Det_TraceDump
+*******************************************************************************/
+extern uint8_t
+Det_TraceRead(DetTrace_t * const Trace)
+{
+  if(Trace == 0x00) return 0;
+
+  return DetTraceRing_Dequeue(&DetTrace, Trace);
+}
+
+/******************************************************************************
+* Function : Det_TraceDump()
+*//**
+* \b Description:
+* This function is used to drain the error trace into a sink, e.g. a debug
+* console or a log file, from the oldest record to the newest one. <br>
+* @param Sink the function every record is passed to
+* @return uint8_t the number of dumped records
+*
+* @see Det_TraceRead
+*******************************************************************************/
+extern uint8_t
+Det_TraceDump(DetTraceSink_t Sink)
+{
+  DetTrace_t Trace;
+  uint8_t Count = 0;
+
+  if(Sink == 0x00) return 0;
+
+  while(Det_TraceRead(&Trace) == 1)
+    {
+      Sink(&Trace);
+      Count++;
+    }
+
+  return Count;
+}
+
+/******************************************************************************
+* Function : Det_TraceGetLost()
+*//**
+* \b Description:
+* This function is used to get the number of records dropped because the
+* error trace was full. <br>
+* @return uint16_t the number of lost records
+*******************************************************************************/
+extern uint16_t
+Det_TraceGetLost(void)
+{
+  return DetTraceLost;
+}
+
+/******************************************************************************
+* Function : Det_TraceGetSuppressed()
+*//**
+* \b Description:
+* This function is used to get the number of reports that were not recorded
+* due to the rate limiting. <br>
+* @return uint16_t the number of suppressed reports
+*******************************************************************************/
+extern uint16_t
+Det_TraceGetSuppressed(void)
+{
+  return DetTraceSuppressed;
+}
+
+/**
+ * @brief Checks if an error of an instance was recorded less than
+ * DET_RATE_LIMIT_TICKS ago and remembers its record time otherwise.
+ * 
+ * @return uint8_t 1 if the report must not be recorded, 0 otherwise
+ */
+static uint8_t
+Det_RateLimited(uint16_t ModuleId, uint8_t InstanceId, uint8_t ApiId,
+  uint8_t ErrorId, uint32_t Timestamp)
+{
+#if (DET_RATE_LIMIT_TICKS != 0)
+  if(DetTickSource == 0x00) return 0;
+
+  //the instance is scaled by an odd number so the instances of an error
+  //take different slots and an instance doesn't cancel out an equal error id
+  DetRateLimit_t * const Slot = &DetRateLimit[(uint8_t) (ModuleId ^ ApiId ^
+    ErrorId ^ (InstanceId * 3)) % DET_RATE_LIMIT_SLOTS];
+
+  if(Slot->ModuleId == ModuleId && Slot->InstanceId == InstanceId &&
+     Slot->ApiId == ApiId && Slot->ErrorId == ErrorId && Slot->Timestamp != 0 &&
+     (uint32_t) (Timestamp - Slot->Timestamp) < DET_RATE_LIMIT_TICKS)
+    {
+      return 1;
+    }
+
+  Slot->ModuleId = ModuleId;
+  Slot->InstanceId = InstanceId;
+  Slot->ApiId = ApiId;
+  Slot->ErrorId = ErrorId;
+  //0 marks a free slot, a record at tick 0 is remembered at tick 1
+  Slot->Timestamp = (Timestamp != 0) ? Timestamp : 1;
+#else
+  (void) ModuleId;
+  (void) InstanceId;
+  (void) ApiId;
+  (void) ErrorId;
+  (void) Timestamp;
+#endif
+
+  return 0;
+}
+
+/**
+ * @brief Writes a record into the error trace, the record is dropped and
+ * counted when the trace is full. Overwriting the oldest record would move
+ * the Rear under a concurrent Det_TraceRead.
+ * 
+ */
+static void
+Det_TraceWrite(uint16_t ModuleId, uint8_t InstanceId, uint8_t ApiId,
+  uint8_t ErrorId, uint32_t Timestamp)
+{
+  DetTrace_t Trace;
+
+  Trace.Timestamp = Timestamp;
+  Trace.ModuleId = ModuleId;
+  Trace.InstanceId = InstanceId;
+  Trace.ApiId = ApiId;
+  Trace.ErrorId = ErrorId;
+
+  if(DetTraceRing_Enqueue(&DetTrace, Trace) == 0)
+    {
+      DetTraceLost++;
+    }
+}
+
+/**
+ * @brief A default error handler 
+ * 
+ */
+static void 
+Det_DefaultHandler(void) 
+{
+  while(1);
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,60 @@
+/**
+ * @file det.h
+ * @author Mohamed Hassanin
+ * @brief a default error tracer for error handling
+ * @version 0.1
+ * @date 2021-03-12
+ */
+#ifndef DET_H
+#define DET_H
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+#include "det_cfg.h"
+/******************************************************************************
+ * typedefs
+ ******************************************************************************/
+/**
+ * @brief A record of the error trace
+ */
+typedef struct
+{
+  uint32_t Timestamp; /**< the tick the error is reported at */
+  uint16_t ModuleId; /**< the module that reported the error */
+  uint8_t InstanceId; /**< the module instance (e.g. the Uart Id) */
+  uint8_t ApiId; /**< the service the error is reported from */
+  uint8_t ErrorId; /**< the error */
+} DetTrace_t;
+
+/**
+ * @brief A source of the tick used to timestamp the error records
+ */
+typedef uint32_t (*DetTickSource_t)(void);
+
+/**
+ * @brief A function the error records are dumped to
+ */
+typedef void (*DetTraceSink_t)(const DetTrace_t * const Trace);
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern void Det_Init(const DetModuleConfig_t * const Config);
+extern void Det_ReportError(uint16_t ModuleId, uint8_t InstanceId, uint8_t ApiId, uint8_t ErrorId);
+
+extern void Det_SetTickSource(DetTickSource_t TickSource);
+extern uint8_t Det_TraceRead(DetTrace_t * const Trace);
+extern uint8_t Det_TraceDump(DetTraceSink_t Sink);
+extern uint16_t Det_TraceGetLost(void);
+extern uint16_t Det_TraceGetSuppressed(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DET_H */
+/*****************************End of File ************************************/
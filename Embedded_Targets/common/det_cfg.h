@@ -0,0 +1,88 @@
+/**
+ * @file det_cfg.h
+ * @author Mohamed Hassanin
+ * @brief A default error tracer configuration header file.
+ * @version 0.1
+ * @date 2021-03-12
+ */
+#ifndef DET_CFG_H
+#define DET_CFG_H
+
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+/**********************************************************************
+* Preprocessor constants
+**********************************************************************/
+#define DET_MODULE_COUNT 2 /**< define the number of rows in the module table,
+it must be greater than the largest module id */
+
+#ifndef DET_TRACE_SIZE
+#define DET_TRACE_SIZE 16 /**< define the number of records in the error trace,
+one record is wasted to know if it's empty */
+#endif
+
+#ifndef DET_RATE_LIMIT_TICKS
+#define DET_RATE_LIMIT_TICKS 10 /**< define the minimum number of ticks between
+two records of the same error, 0 to disable the rate limiting */
+#endif
+
+#ifndef DET_RATE_LIMIT_SLOTS
+#define DET_RATE_LIMIT_SLOTS 8 /**< define the number of errors whose last
+record time is remembered for the rate limiting */
+#endif
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+/**
+ * Defines what is done with a reported error
+ */
+typedef enum
+{
+  DET_SEVERITY_IGNORE, /**< the error is dropped */
+  DET_SEVERITY_TRACE, /**< the error is recorded in the error trace */
+  DET_SEVERITY_HANDLE, /**< the error is recorded and passed to its handler */
+  DET_SEVERITY_HALT, /**< the error is recorded, passed to its handler and
+  the CPU is halted (debugging only) */
+} DetSeverity_t;
+
+/**
+ * A handler of a reported error
+ */
+typedef void (*DetHandler_t)(uint8_t InstanceId, uint8_t ApiId, uint8_t ErrorId);
+
+/**
+ * Defines the handling of an error of a module
+ */
+typedef struct
+{
+  DetSeverity_t Severity; /**< what is done with the error */
+  DetHandler_t Handler; /**< the handler of the error, 0x00 if none */
+} DetErrorConfig_t;
+
+/**
+ * Defines the handling of the errors of a module, a row of the module table
+ * indexed by the module id
+ */
+typedef struct
+{
+  const DetErrorConfig_t * Errors; /**< the error table indexed by the error
+  id, 0x00 if the module errors are only traced */
+  uint8_t ErrorCount; /**< the number of rows in the error table */
+} DetModuleConfig_t;
+/**********************************************************************
+* Function Prototypes
+**********************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern const DetModuleConfig_t* Det_GetConfig(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* DET_CFG_H */
+/*****************************End of File ************************************/
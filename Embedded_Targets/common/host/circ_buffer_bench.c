@@ -0,0 +1,135 @@
+/**
+ * @file circ_buffer_bench.c
+ * @author Mohamed Hassanin
+ * @brief A host benchmark of the circular buffer bulk copies and search
+ * against the byte loops they replace, for the kernel selected at build
+ * time:
+ * @code
+ * for k in 0 1 2; do
+ *   gcc -std=c99 -O2 -DCIRCBUFF_KERNEL=$k -I.. circ_buffer_bench.c \
+ *     ../circ_buffer.c -o bench && ./bench
+ * done
+ * @endcode
+ * The buffer has 255 slots and wraps in the middle of every call.
+ * @version 0.1
+ * @date 2021-03-08
+ */
+#define _POSIX_C_SOURCE 199309L /**< for clock_gettime */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <time.h>
+#include "circ_buffer.h"
+/******************************************************************************
+ * Preprocessor constants
+ ******************************************************************************/
+#define BENCH_ROUNDS 200000ul /**< the number of calls per measurement */
+#define BENCH_BYTES 254 /**< the number of bytes per call, a full buffer */
+#define BENCH_START 128 /**< the position of the oldest byte */
+#define BENCH_KEY 0xAA /**< the searched byte, the last one of the buffer */
+/******************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+static uint8_t BenchMem[BENCH_BYTES + 1]; /**< the memory of the buffer */
+static uint8_t BenchIn[BENCH_BYTES]; /**< the bytes written */
+static uint8_t BenchOut[BENCH_BYTES]; /**< the bytes read */
+static volatile uint8_t BenchSink; /**< keeps the results alive */
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Bench_Now()
+*//**
+* \b Description:
+* Utility function is used to read the monotonic clock.
+*
+* @return double the time in ns
+*******************************************************************************/
+static double
+Bench_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec * 1e9 + Time.tv_nsec;
+}
+
+/******************************************************************************
+* Function : Bench_Reset()
+*//**
+* \b Description:
+* Utility function is used to empty the buffer at the benchmark position.
+*
+* @param Buff a valid pointer to the circuler buffer
+* @return void
+*******************************************************************************/
+static void
+Bench_Reset(CircBuff_t* Buff)
+{
+  Buff->State.Rear = BENCH_START;
+  Buff->State.Front = BENCH_START;
+}
+
+int
+main(void)
+{
+  CircBuff_t Buff = CircBuff_Create(BenchMem, sizeof(BenchMem));
+  double Start, ByteCopy, BulkCopy, ByteFind, BulkFind;
+  unsigned long Round;
+  uint8_t i;
+
+  //no key in the data, the searches run to the last byte
+  for(i = 0; i < BENCH_BYTES; i++) BenchIn[i] = i & 0x7F;
+
+  Start = Bench_Now();
+  for(Round = 0; Round < BENCH_ROUNDS; Round++)
+    {
+      Bench_Reset(&Buff);
+      for(i = 0; i < BENCH_BYTES; i++) CircBuff_Enqueue(&Buff, BenchIn[i]);
+      for(i = 0; i < BENCH_BYTES; i++) CircBuff_Dequeue(&Buff, &BenchOut[i]);
+      BenchSink += BenchOut[Round % BENCH_BYTES];
+    }
+  ByteCopy = (Bench_Now() - Start) / BENCH_ROUNDS / BENCH_BYTES;
+
+  Start = Bench_Now();
+  for(Round = 0; Round < BENCH_ROUNDS; Round++)
+    {
+      Bench_Reset(&Buff);
+      CircBuff_EnqueueBulk(&Buff, BenchIn, BENCH_BYTES);
+      CircBuff_DequeueBulk(&Buff, BenchOut, BENCH_BYTES);
+      BenchSink += BenchOut[Round % BENCH_BYTES];
+    }
+  BulkCopy = (Bench_Now() - Start) / BENCH_ROUNDS / BENCH_BYTES;
+
+  Bench_Reset(&Buff);
+  CircBuff_EnqueueBulk(&Buff, BenchIn, BENCH_BYTES - 1);
+  CircBuff_Enqueue(&Buff, BENCH_KEY);
+
+  Start = Bench_Now();
+  for(Round = 0; Round < BENCH_ROUNDS; Round++)
+    {
+      for(i = Round & 0x01; i < BENCH_BYTES; i++)
+        {
+          uint8_t Data;
+          CircBuff_PeekAt(&Buff, i, &Data);
+          if(Data == BENCH_KEY) break;
+        }
+      BenchSink += i;
+    }
+  ByteFind = (Bench_Now() - Start) / BENCH_ROUNDS / BENCH_BYTES;
+
+  Start = Bench_Now();
+  for(Round = 0; Round < BENCH_ROUNDS; Round++)
+    {
+      BenchSink += CircBuff_Find(&Buff, BENCH_KEY, Round & 0x01);
+    }
+  BulkFind = (Bench_Now() - Start) / BENCH_ROUNDS / BENCH_BYTES;
+
+  printf("kernel %d, ns per byte:\n", CIRCBUFF_KERNEL);
+  printf("  enqueue+dequeue  byte loop   %6.3f  bulk %6.3f\n", ByteCopy, BulkCopy);
+  printf("  find             PeekAt loop %6.3f  find %6.3f\n", ByteFind, BulkFind);
+
+  return 0;
+}
+/*****************************End of File ************************************/
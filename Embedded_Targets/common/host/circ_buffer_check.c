@@ -0,0 +1,172 @@
+/**
+ * @file circ_buffer_check.c
+ * @author Mohamed Hassanin
+ * @brief A randomized check of the circular buffer bulk copies, span peek,
+ * search and skip against a byte-by-byte reference, run on a host for every
+ * kernel:
+ * @code
+ * for k in 0 1 2; do
+ *   gcc -std=c99 -O2 -DCIRCBUFF_KERNEL=$k -I.. circ_buffer_check.c \
+ *     ../circ_buffer.c -o check && ./check || break
+ * done
+ * @endcode
+ * The reference is a second buffer of the same size and wrap position driven
+ * by CircBuff_Enqueue, CircBuff_Dequeue and CircBuff_PeekAt only.
+ * @version 0.1
+ * @date 2021-03-08
+ */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "circ_buffer.h"
+/******************************************************************************
+ * Preprocessor constants
+ ******************************************************************************/
+#define CHECK_ROUNDS 200000ul /**< the number of random buffers checked */
+#define CHECK_OPS 8 /**< the number of random operations per buffer */
+/******************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+static unsigned long CheckFailed; /**< the number of mismatches */
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Check_Byte()
+*//**
+* \b Description:
+* Utility function is used to draw a random byte, one out of four is one of
+* three keys so the searches hit often.
+*
+* @return uint8_t the byte
+*******************************************************************************/
+static uint8_t
+Check_Byte(void)
+{
+  return (rand() % 4) ? (uint8_t) rand() : (uint8_t) (0x80 + rand() % 3);
+}
+
+/******************************************************************************
+* Function : Check_Fail()
+*//**
+* \b Description:
+* Utility function is used to count a mismatch and print the first ones.
+*
+* @param Op the checked operation
+* @param Size the size of the buffer
+* @param Round the round of the mismatch
+* @return void
+*******************************************************************************/
+static void
+Check_Fail(const char* Op, uint8_t Size, unsigned long Round)
+{
+  if(CheckFailed++ < 10)
+    {
+      printf("%s mismatch, size %u, round %lu\n", Op, Size, Round);
+    }
+}
+
+/******************************************************************************
+* Function : Check_Round()
+*//**
+* \b Description:
+* Utility function is used to run random operations on a buffer of a random
+* size and wrap position and to compare them with the reference.
+*
+* @param Round the round number, printed on a mismatch
+* @return void
+*******************************************************************************/
+static void
+Check_Round(unsigned long Round)
+{
+  uint8_t Mem[255], RefMem[255];
+  uint8_t In[255], Out[255], RefOut[255];
+  uint8_t Size = (uint8_t) (2 + rand() % 254);
+  uint8_t Start = (uint8_t) (rand() % Size);
+  CircBuff_t Buff = CircBuff_Create(Mem, Size);
+  CircBuff_t Ref = CircBuff_Create(RefMem, Size);
+
+  Buff.State.Rear = Buff.State.Front = Start;
+  Ref.State.Rear = Ref.State.Front = Start;
+
+  for(uint8_t Op = 0; Op < CHECK_OPS; Op++)
+    {
+      uint8_t Count = (uint8_t) (rand() % (Size + 2));
+      uint8_t Offset = (uint8_t) (rand() % (CircBuff_Count(&Ref) + 2));
+      uint8_t Key = Check_Byte();
+      uint8_t Got, Exp, i;
+
+      switch(rand() % 5)
+        {
+        case 0:
+          for(i = 0; i < Count; i++) In[i] = Check_Byte();
+          Got = CircBuff_EnqueueBulk(&Buff, In, Count);
+          for(Exp = 0; Exp < Count && CircBuff_Enqueue(&Ref, In[Exp]); Exp++);
+          if(Got != Exp) Check_Fail("EnqueueBulk", Size, Round);
+          break;
+
+        case 1:
+          Got = CircBuff_DequeueBulk(&Buff, Out, Count);
+          for(Exp = 0; Exp < Count && CircBuff_Dequeue(&Ref, &RefOut[Exp]); Exp++);
+          if(Got != Exp || memcmp(Out, RefOut, Exp) != 0)
+            Check_Fail("DequeueBulk", Size, Round);
+          break;
+
+        case 2:
+          Got = CircBuff_PeekSpan(&Buff, Out, Offset, Count);
+          for(Exp = 0; Exp < Count &&
+                CircBuff_PeekAt(&Ref, (uint8_t) (Offset + Exp), &RefOut[Exp]); Exp++);
+          if(Got != Exp || memcmp(Out, RefOut, Exp) != 0)
+            Check_Fail("PeekSpan", Size, Round);
+          break;
+
+        case 3:
+          Got = CircBuff_Find(&Buff, Key, Offset);
+          Exp = CIRCBUFF_NOT_FOUND;
+          for(i = Offset; i < CircBuff_Count(&Ref); i++)
+            {
+              uint8_t Data;
+              CircBuff_PeekAt(&Ref, i, &Data);
+              if(Data == Key)
+                {
+                  Exp = i;
+                  break;
+                }
+            }
+          if(Got != Exp) Check_Fail("Find", Size, Round);
+          break;
+
+        default:
+          Got = CircBuff_Skip(&Buff, Count);
+          for(Exp = 0; Exp < Count && CircBuff_Dequeue(&Ref, &RefOut[0]); Exp++);
+          if(Got != Exp) Check_Fail("Skip", Size, Round);
+          break;
+        }
+
+      if(CircBuff_Count(&Buff) != CircBuff_Count(&Ref) ||
+         Buff.State.Rear != Ref.State.Rear || Buff.State.Front != Ref.State.Front)
+        {
+          Check_Fail("State", Size, Round);
+        }
+    }
+}
+
+int
+main(void)
+{
+  srand(1);
+
+  for(unsigned long Round = 0; Round < CHECK_ROUNDS; Round++)
+    {
+      Check_Round(Round);
+    }
+
+  printf("kernel %d: %lu rounds, %lu mismatches\n", CIRCBUFF_KERNEL,
+    CHECK_ROUNDS, CheckFailed);
+
+  return CheckFailed == 0 ? 0 : 1;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,190 @@
+/**
+ * @file circ_buffer_inline_bench.c
+ * @author Mohamed Hassanin
+ * @brief A host benchmark of the per byte circular buffer paths the UART
+ * driver chooses between with UART_CIRCBUFF_INLINE:
+ * @code
+ * gcc -std=gnu99 -Os -I.. circ_buffer_inline_bench.c ../circ_buffer.c \
+ *   -o inline_bench && ./inline_bench
+ * @endcode
+ * Every update enqueues and dequeues one byte of an 80-byte buffer, like a
+ * receive update followed by Uart_ReceiveByte. The update is a function of
+ * its own so the buffer state is loaded and stored on every byte as in the
+ * driver. The paths are:
+ * - inline: CircBuff_EnqueueSized/DequeueSized with the size known at
+ *   compile time (UART_CIRCBUFF_INLINE 1).
+ * - out-of-line: the same bodies behind one function of the driver
+ *   (UART_CIRCBUFF_INLINE 0).
+ * - library call: CircBuff_Enqueue/Dequeue with their pointer checks.
+ * @version 0.1
+ * @date 2021-03-08
+ */
+#define _POSIX_C_SOURCE 199309L /**< for clock_gettime */
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <time.h>
+#include "circ_buffer.h"
+/******************************************************************************
+ * Preprocessor constants
+ ******************************************************************************/
+#define BENCH_ROUNDS 20000000ul /**< the number of updates per measurement */
+#define BENCH_SIZE 80 /**< the size of the buffer, UART_BUFF_SIZE */
+#define BENCH_NOINLINE __attribute__((noinline)) /**< keeps a function out of
+line like a function of another translation unit */
+/******************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+static uint8_t BenchMem[BENCH_SIZE]; /**< the memory of the buffer */
+static CircBuffState_t BenchState; /**< the buffer of the sized paths */
+static CircBuff_t BenchBuff; /**< the buffer of the library calls */
+static volatile uint8_t BenchSink; /**< keeps the results alive */
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Bench_Now()
+*//**
+* \b Description:
+* Utility function is used to read the monotonic clock.
+*
+* @return double the time in ns
+*******************************************************************************/
+static double
+Bench_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec * 1e9 + Time.tv_nsec;
+}
+
+/******************************************************************************
+* Function : Bench_Enqueue()
+*//**
+* \b Description:
+* The out-of-line enqueue of the driver (Uart_Enqueue).
+*
+* @param Data the byte to enqueue
+* @return uint8_t 1 if the byte is stored and 0 otherwise
+*******************************************************************************/
+static BENCH_NOINLINE uint8_t
+Bench_Enqueue(const uint8_t Data)
+{
+  return CircBuff_EnqueueSized(&BenchState, BenchMem, BENCH_SIZE, Data);
+}
+
+/******************************************************************************
+* Function : Bench_Dequeue()
+*//**
+* \b Description:
+* The out-of-line dequeue of the driver (Uart_Dequeue).
+*
+* @param Data a valid pointer to store the dequeued byte in
+* @return uint8_t 1 if there's a valid byte returned, 0 otherwise
+*******************************************************************************/
+static BENCH_NOINLINE uint8_t
+Bench_Dequeue(uint8_t * const Data)
+{
+  return CircBuff_DequeueSized(&BenchState, BenchMem, BENCH_SIZE, Data);
+}
+
+/******************************************************************************
+* Function : Bench_UpdateInline()
+*//**
+* \b Description:
+* One update through the inline path.
+*
+* @param Data the byte to pass through the buffer
+* @return uint8_t the byte read back
+*******************************************************************************/
+static BENCH_NOINLINE uint8_t
+Bench_UpdateInline(const uint8_t Data)
+{
+  uint8_t Out = 0;
+
+  CircBuff_EnqueueSized(&BenchState, BenchMem, BENCH_SIZE, Data);
+  CircBuff_DequeueSized(&BenchState, BenchMem, BENCH_SIZE, &Out);
+  return Out;
+}
+
+/******************************************************************************
+* Function : Bench_UpdateOutOfLine()
+*//**
+* \b Description:
+* One update through the out-of-line path.
+*
+* @param Data the byte to pass through the buffer
+* @return uint8_t the byte read back
+*******************************************************************************/
+static BENCH_NOINLINE uint8_t
+Bench_UpdateOutOfLine(const uint8_t Data)
+{
+  uint8_t Out = 0;
+
+  Bench_Enqueue(Data);
+  Bench_Dequeue(&Out);
+  return Out;
+}
+
+/******************************************************************************
+* Function : Bench_UpdateCall()
+*//**
+* \b Description:
+* One update through the library calls.
+*
+* @param Data the byte to pass through the buffer
+* @return uint8_t the byte read back
+*******************************************************************************/
+static BENCH_NOINLINE uint8_t
+Bench_UpdateCall(const uint8_t Data)
+{
+  uint8_t Out = 0;
+
+  CircBuff_Enqueue(&BenchBuff, Data);
+  CircBuff_Dequeue(&BenchBuff, &Out);
+  return Out;
+}
+
+/******************************************************************************
+* Function : Bench_Run()
+*//**
+* \b Description:
+* Utility function is used to time an update path.
+*
+* @param Update the update to time
+* @return double the time of an update in ns
+*******************************************************************************/
+static double
+Bench_Run(uint8_t (*Update)(const uint8_t Data))
+{
+  double Start = Bench_Now();
+  uint8_t Sum = 0;
+
+  for(unsigned long Round = 0; Round < BENCH_ROUNDS; Round++)
+    {
+      Sum += Update((uint8_t) Round);
+    }
+  BenchSink = Sum;
+
+  return (Bench_Now() - Start) / BENCH_ROUNDS;
+}
+
+int
+main(void)
+{
+  BenchState = CircBuff_CreateState(CIRCBUFF_DROP_NEW);
+  BenchBuff = CircBuff_Create(BenchMem, BENCH_SIZE);
+
+  //a first pass warms up the caches and the clock
+  (void) Bench_Run(Bench_UpdateCall);
+
+  printf("ns per byte (enqueue + dequeue):\n");
+  printf("  inline        %6.3f\n", Bench_Run(Bench_UpdateInline));
+  printf("  out-of-line   %6.3f\n", Bench_Run(Bench_UpdateOutOfLine));
+  printf("  library call  %6.3f\n", Bench_Run(Bench_UpdateCall));
+
+  return 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,241 @@
+/**
+ * @file uart_pty_bench.c
+ * @author Mohamed Hassanin
+ * @brief A benchmark of the Linux port over pseudo-terminal pairs: the
+ * aggregate echo throughput and the CPU use of the epoll event loop against
+ * the Uart_ServiceAll spin, as the number of active channels scales, for the
+ * number of open channels selected at build time:
+ * @code
+ * for n in 16 128 250; do
+ *   gcc -std=gnu11 -O2 -DUART_HOST_CHANNELS=$n -I.. -I../../common \
+ *     uart_pty_bench.c ../uart.c ../det_cfg.c ../../common/circ_buffer.c \
+ *     ../../common/det.c -o pty_bench && ./pty_bench
+ * done
+ * @endcode
+ * Every round the active channels (spread over the open ones) receive
+ * BENCH_BYTES bytes from the peer and echo them back, a round ends when the
+ * peer got every echo. The CPU time is the user and system time of the
+ * process, the peer included.
+ * @version 0.1
+ * @date 2021-03-20
+ */
+/******************************************************************************
+ * definitions
+ ******************************************************************************/
+#define _GNU_SOURCE /**< posix_openpt and ptsname */
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+#include "uart.h"
+#include "det.h"
+/******************************************************************************
+ * Preprocessor constants
+ ******************************************************************************/
+#define BENCH_BYTES 64 /**< the bytes echoed by an active channel per round */
+#define BENCH_WAIT_MS 100 /**< the longest wait of Uart_EpollWait */
+#define BENCH_ROUND_BYTES 64000 /**< about the bytes echoed per measurement */
+/******************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+static char BenchNames[UART_MAX][64]; /**< the slave device of every pair */
+static int BenchMasters[UART_MAX]; /**< the master side of every pair */
+static UartConfig_t BenchConfig[UART_MAX]; /**< the channels, one per pair */
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Bench_Now()
+*//**
+* \b Description:
+* Utility function is used to read the monotonic clock.
+*
+* @return double the time in s
+*******************************************************************************/
+static double
+Bench_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec + Time.tv_nsec * 1e-9;
+}
+
+/******************************************************************************
+* Function : Bench_Cpu()
+*//**
+* \b Description:
+* Utility function is used to read the CPU time of the process.
+*
+* @return double the user and system time in s
+*******************************************************************************/
+static double
+Bench_Cpu(void)
+{
+  struct rusage Usage;
+
+  getrusage(RUSAGE_SELF, &Usage);
+  return Usage.ru_utime.tv_sec + Usage.ru_stime.tv_sec +
+    (Usage.ru_utime.tv_usec + Usage.ru_stime.tv_usec) * 1e-6;
+}
+
+/******************************************************************************
+* Function : Bench_Echo()
+*//**
+* \b Description:
+* The receive hook of the event loop, the received bytes are sent back.
+*
+* @param Uart the Uart Id
+* @return void
+*******************************************************************************/
+static void
+Bench_Echo(const Uart_t Uart)
+{
+  uint8_t Data[UART_BUFF_SIZE];
+  uint8_t Length = Uart_PeekString(Uart, Data, 0, sizeof(Data));
+
+  Uart_Skip(Uart, Uart_SendString(Uart, Data, Length));
+}
+
+/******************************************************************************
+* Function : Bench_Spin()
+*//**
+* \b Description:
+* One pass of the polled loop: every channel is updated, the received bytes
+* are sent back and sent right away.
+*
+* @return void
+*******************************************************************************/
+static void
+Bench_Spin(void)
+{
+  uint8_t Data;
+
+  Uart_ServiceAll();
+  for(uint8_t i = 0; i < UART_MAX; i++)
+    {
+      if(Uart_PeekString((Uart_t) i, &Data, 0, 1) != 0) Bench_Echo((Uart_t) i);
+    }
+  Uart_ServiceAll();
+}
+
+/******************************************************************************
+* Function : Bench_Run()
+*//**
+* \b Description:
+* Utility function is used to measure the echo of a number of active channels
+* and to print the throughput and the CPU use.
+*
+* @param Active the number of active channels, 1 to UART_MAX
+* @param Epoll 1 for the epoll event loop, 0 for the Uart_ServiceAll spin
+* @return void
+*******************************************************************************/
+static void
+Bench_Run(const int Active, const int Epoll)
+{
+  static uint8_t Echoed[BENCH_BYTES];
+  uint8_t Sent[BENCH_BYTES];
+  int Rounds = BENCH_ROUND_BYTES / (Active * BENCH_BYTES);
+  int Stride = UART_MAX / Active;
+  double Start = Bench_Now();
+  double CpuStart = Bench_Cpu();
+  double Time;
+  double Cpu;
+
+  memset(Sent, 0x5A, sizeof(Sent));
+  if(Rounds < 10) Rounds = 10;
+
+  for(int Round = 0; Round < Rounds; Round++)
+    {
+      int Received[UART_MAX] = { 0 };
+      int Left = Active;
+
+      for(int i = 0; i < Active; i++)
+        {
+          if(write(BenchMasters[i * Stride], Sent, sizeof(Sent)) != sizeof(Sent))
+            {
+              printf("peer write failed\n");
+              exit(1);
+            }
+        }
+
+      while(Left != 0)
+        {
+          if(Epoll == 1) Uart_EpollWait(BENCH_WAIT_MS);
+          else Bench_Spin();
+
+          for(int i = 0; i < Active; i++)
+            {
+              int Channel = i * Stride;
+              int Count;
+
+              if(Received[Channel] == BENCH_BYTES) continue;
+
+              Count = read(BenchMasters[Channel], Echoed, BENCH_BYTES - Received[Channel]);
+              if(Count > 0)
+                {
+                  Received[Channel] += Count;
+                  if(Received[Channel] == BENCH_BYTES) Left--;
+                }
+            }
+        }
+    }
+
+  Time = Bench_Now() - Start;
+  Cpu = Bench_Cpu() - CpuStart;
+
+  printf("%3d/%3d  %-10s  %8.1f kB/s  %7.1f us/round  cpu %7.1f us/round\n",
+    Active, UART_MAX, Epoll == 1 ? "epoll" : "ServiceAll",
+    (double) Active * BENCH_BYTES * Rounds / Time / 1e3,
+    Time / Rounds * 1e6, Cpu / Rounds * 1e6);
+}
+
+int
+main(void)
+{
+  for(int i = 0; i < UART_MAX; i++)
+    {
+      BenchMasters[i] = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+      if(BenchMasters[i] < 0 || grantpt(BenchMasters[i]) != 0 ||
+         unlockpt(BenchMasters[i]) != 0)
+        {
+          printf("no pseudo-terminal\n");
+          return 1;
+        }
+      strcpy(BenchNames[i], ptsname(BenchMasters[i]));
+
+      BenchConfig[i] = (UartConfig_t) { (Uart_t) i, BenchNames[i], 115200,
+        UART_STOP_BIT_1, UART_PARTIY_NO, UART_DATA_BITS_8,
+        UART_FLOW_CONTROL_NONE, CIRCBUFF_DROP_NEW };
+    }
+
+  Det_Init(Det_GetConfig());
+  Uart_Init(BenchConfig);
+  if(Uart_EpollInit(Bench_Echo) != 1)
+    {
+      printf("no event loop\n");
+      return 1;
+    }
+
+  printf("active/open  loop         throughput   wall time          cpu time\n");
+  for(int Active = 1; Active <= UART_MAX; Active *= 4)
+    {
+      //the spin services the channels itself, the event loop hook is unset
+      Bench_Run(Active, 1);
+      Uart_EpollInit(0x00);
+      Bench_Run(Active, 0);
+      Uart_EpollInit(Bench_Echo);
+    }
+
+  Uart_Deinit();
+
+  return 0;
+}
+/*****************************End of File ************************************/
@@ -0,0 +1,282 @@
+/**
+ * @file uart_pty_check.c
+ * @author Mohamed Hassanin
+ * @brief A check of the Linux port over pseudo-terminal pairs, no serial
+ * hardware is needed. The driver opens the slave side of every pair and the
+ * check plays the peer on the master side:
+ * @code
+ * gcc -std=gnu11 -O2 -I.. -I../../common uart_pty_check.c ../uart.c \
+ *   ../det_cfg.c ../../common/circ_buffer.c ../../common/det.c \
+ *   -Wl,--wrap=ioctl -o pty_check && ./pty_check
+ * @endcode
+ * A pty output queue always reads as empty (TIOCOUTQ), so ioctl(2) is
+ * wrapped to make the tty of a channel look busy while a deferred
+ * reconfiguration is checked.
+ * @version 0.1
+ * @date 2021-03-20
+ */
+/******************************************************************************
+ * definitions
+ ******************************************************************************/
+#define _GNU_SOURCE /**< posix_openpt and ptsname */
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "uart.h"
+#include "det.h"
+/******************************************************************************
+ * Preprocessor constants
+ ******************************************************************************/
+#define CHECK_BYTES 1000 /**< the number of bytes echoed by every channel */
+#define CHECK_WAIT_MS 100 /**< the longest wait accepted for Uart_EpollWait(-1)
+while a reconfiguration is deferred */
+/******************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+static char CheckNames[UART_MAX][64]; /**< the slave device of every pair */
+static int CheckMasters[UART_MAX]; /**< the master side of every pair */
+static UartConfig_t CheckConfig[UART_MAX]; /**< the channels, one per pair */
+static int CheckOutQueue; /**< the tty output queue reported by TIOCOUTQ */
+static unsigned CheckFailed; /**< the number of failed checks */
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+extern int __real_ioctl(int Fd, unsigned long Request, ...);
+
+/******************************************************************************
+* Function : __wrap_ioctl()
+*//**
+* \b Description:
+* The ioctl(2) seen by the driver, TIOCOUTQ reports CheckOutQueue and the
+* other requests go to the real ioctl(2).
+*
+* @param Fd the file descriptor
+* @param Request the request
+* @return int the result of the request
+*******************************************************************************/
+extern int
+__wrap_ioctl(int Fd, unsigned long Request, ...)
+{
+  va_list Args;
+  void* Arg;
+
+  va_start(Args, Request);
+  Arg = va_arg(Args, void*);
+  va_end(Args);
+
+  if(Request == TIOCOUTQ)
+    {
+      *(int*) Arg = CheckOutQueue;
+      return 0;
+    }
+
+  return __real_ioctl(Fd, Request, Arg);
+}
+
+/******************************************************************************
+* Function : Check()
+*//**
+* \b Description:
+* Utility function is used to print the result of a check.
+*
+* @param Name the check name
+* @param Passed 1 if the check passed
+* @return void
+*******************************************************************************/
+static void
+Check(const char* Name, int Passed)
+{
+  printf("%-44s %s\n", Name, Passed ? "ok" : "FAILED");
+  if(!Passed) CheckFailed++;
+}
+
+/******************************************************************************
+* Function : Check_Now()
+*//**
+* \b Description:
+* Utility function is used to read the monotonic clock.
+*
+* @return double the time in ms
+*******************************************************************************/
+static double
+Check_Now(void)
+{
+  struct timespec Time;
+
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return Time.tv_sec * 1e3 + Time.tv_nsec * 1e-6;
+}
+
+/******************************************************************************
+* Function : Check_Echo()
+*//**
+* \b Description:
+* The receive hook of the event loop, the received bytes are sent back.
+*
+* @param Uart the Uart Id
+* @return void
+*******************************************************************************/
+static void
+Check_Echo(const Uart_t Uart)
+{
+  uint8_t Data[255];
+  uint8_t Length = Uart_PeekString(Uart, Data, 0, sizeof(Data));
+
+  Uart_Skip(Uart, Uart_SendString(Uart, Data, Length));
+}
+
+/******************************************************************************
+* Function : Check_EchoAll()
+*//**
+* \b Description:
+* Utility function is used to write random bytes to every channel and to
+* check they're echoed back in order through the event loop.
+*
+* @return int 1 if every channel echoed its bytes
+*******************************************************************************/
+static int
+Check_EchoAll(void)
+{
+  static uint8_t Sent[UART_MAX][CHECK_BYTES], Echoed[UART_MAX][CHECK_BYTES];
+  int Written[UART_MAX] = { 0 }, Read[UART_MAX] = { 0 };
+  int Left = UART_MAX;
+
+  for(int i = 0; i < UART_MAX; i++)
+    {
+      for(int j = 0; j < CHECK_BYTES; j++) Sent[i][j] = (uint8_t) rand();
+    }
+
+  for(int Round = 0; Left != 0 && Round < 10000; Round++)
+    {
+      for(int i = 0; i < UART_MAX; i++)
+        {
+          int Count = CHECK_BYTES - Written[i];
+          if(Count > 97) Count = 97;
+          if(Count > 0)
+            {
+              Count = write(CheckMasters[i], &Sent[i][Written[i]], Count);
+              if(Count > 0) Written[i] += Count;
+            }
+        }
+
+      Uart_EpollWait(10);
+
+      for(int i = 0; i < UART_MAX; i++)
+        {
+          if(Read[i] == CHECK_BYTES) continue;
+
+          int Count = read(CheckMasters[i], &Echoed[i][Read[i]], CHECK_BYTES - Read[i]);
+          if(Count > 0)
+            {
+              Read[i] += Count;
+              if(Read[i] == CHECK_BYTES) Left--;
+            }
+        }
+    }
+
+  return Left == 0 && memcmp(Sent, Echoed, sizeof(Sent)) == 0;
+}
+
+/******************************************************************************
+* Function : Check_Reconfigure()
+*//**
+* \b Description:
+* Utility function is used to check a deferred reconfiguration: the bytes
+* queued before it leave at the old settings, the bytes queued after it
+* wait for the new settings, and Uart_EpollWait(-1) doesn't block while the
+* tty output queue drains.
+*
+* @return void
+*******************************************************************************/
+static void
+Check_Reconfigure(void)
+{
+  UartConfig_t Fast = CheckConfig[UART_0];
+  struct termios Tty;
+  char Data[16];
+  double Start;
+  int Count;
+
+  Fast.Baudrate = 115200;
+
+  Uart_SendString(UART_0, (const uint8_t*) "AAAA", 4);
+  CheckOutQueue = 10;
+  Check("reconfigure deferred while sending", Uart_Reconfigure(UART_0, &Fast) == 0);
+  Uart_SendString(UART_0, (const uint8_t*) "BB", 2);
+
+  Start = Check_Now();
+  Uart_EpollWait(-1);
+  Check("wait(-1) returns while the tty drains", Check_Now() - Start < CHECK_WAIT_MS);
+
+  Count = read(CheckMasters[UART_0], Data, sizeof(Data));
+  Check("only the bytes queued before are sent", Count == 4 && memcmp(Data, "AAAA", 4) == 0);
+
+  tcgetattr(Uart_GetFd(UART_0), &Tty);
+  Check("old settings kept while the tty drains", cfgetospeed(&Tty) == B9600);
+
+  CheckOutQueue = 0;
+  Start = Check_Now();
+  Uart_EpollWait(-1);
+  Check("wait(-1) applies it once the tty drained", Check_Now() - Start < CHECK_WAIT_MS);
+
+  tcgetattr(Uart_GetFd(UART_0), &Tty);
+  Check("new settings applied", cfgetospeed(&Tty) == B115200);
+
+  Uart_EpollWait(10);
+  Count = read(CheckMasters[UART_0], Data, sizeof(Data));
+  Check("the bytes queued after are sent", Count == 2 && memcmp(Data, "BB", 2) == 0);
+}
+
+int
+main(void)
+{
+  DetTrace_t Trace;
+
+  for(int i = 0; i < UART_MAX; i++)
+    {
+      CheckMasters[i] = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+      if(CheckMasters[i] < 0 || grantpt(CheckMasters[i]) != 0 ||
+         unlockpt(CheckMasters[i]) != 0)
+        {
+          printf("no pseudo-terminal\n");
+          return 1;
+        }
+      strcpy(CheckNames[i], ptsname(CheckMasters[i]));
+
+      CheckConfig[i] = (UartConfig_t) { (Uart_t) i, CheckNames[i], 9600,
+        UART_STOP_BIT_1, UART_PARTIY_NO, UART_DATA_BITS_8,
+        UART_FLOW_CONTROL_NONE, CIRCBUFF_DROP_NEW };
+    }
+
+  Det_Init(Det_GetConfig());
+  Uart_Init(CheckConfig);
+  Check("event loop created", Uart_EpollInit(Check_Echo) == 1);
+
+  Check("every channel echoes through the event loop", Check_EchoAll());
+
+  Uart_EpollInit(0x00);
+  Check_Reconfigure();
+
+  while(Det_TraceRead(&Trace) == 1)
+    {
+      printf("det instance %u api %u error %u\n", Trace.InstanceId, Trace.ApiId,
+        Trace.ErrorId);
+      CheckFailed++;
+    }
+
+  Uart_Deinit();
+
+  printf("%u failed\n", CheckFailed);
+  return CheckFailed == 0 ? 0 : 1;
+}
+/*****************************End of File ************************************/
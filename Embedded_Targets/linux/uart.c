@@ -0,0 +1,1242 @@
+/**
+ * @file uart.c
+ * @author Mohamed Hassanin
+ * @brief A UART driver for Linux hosts. Every channel is a tty file
+ * descriptor opened non-blocking, the updates move the whole content of
+ * the circular buffers with one readv(2) or writev(2) each instead of one
+ * byte per update. The epoll event loop services only the channels the
+ * kernel reports ready, for hosts with tens or hundreds of serial links.
+ * @version 0.1
+ * @date 2021-03-20
+ */
+/******************************************************************************
+ * definitions
+ ******************************************************************************/
+#define _DEFAULT_SOURCE /**< cfmakeraw and the Linux termios speeds */
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "uart.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#if (UART_EPOLL == 1)
+#include <sys/epoll.h>
+#endif
+#include <termios.h>
+#include <unistd.h>
+#include "circ_buffer.h"
+#include "det.h"
+/******************************************************************************
+ * typedefs
+ ******************************************************************************/
+/**
+ * @brief The control block of a UART channel
+ */
+typedef struct
+{
+  CircBuff_t SendBuff; /**< the send buffer */
+  CircBuff_t ReceiveBuff; /**< the receive buffer */
+  int Fd; /**< the tty file descriptor, -1 if the channel isn't open, only
+  valid once Config is set */
+  const UartConfig_t * Config; /**< the current configuration, 0x00 until
+  Uart_Init */
+  const UartConfig_t * PendingConfig; /**< the configuration to apply once
+  the bytes queued before it left the host, 0x00 if none */
+  uint8_t PendingConfigPos; /**< the send buffer position to apply it at */
+#if (UART_EPOLL == 1)
+  uint32_t EpollEvents; /**< the events the tty is registered for, 0 if it
+  isn't registered */
+  uint8_t RxPaused; /**< 1 if EPOLLIN is off because the receive buffer is
+  full and flow control holds the peer off */
+#endif
+} UartChannel_t;
+
+/**
+ * @brief A termios speed and its baudrate
+ */
+typedef struct
+{
+  uint32_t Baudrate; /**< the baudrate */
+  speed_t Speed; /**< the termios speed */
+} UartSpeed_t;
+/******************************************************************************
+* Module Variable Definitions
+*******************************************************************************/
+/**
+ * brief the UART send and receive buffers data
+ */
+static uint8_t UartSendData[UART_MAX][UART_BUFF_SIZE];
+static uint8_t UartReceiveData[UART_MAX][UART_BUFF_SIZE];
+
+/**
+ * brief the UART channels control blocks
+ */
+static UartChannel_t UartChannels[UART_MAX];
+
+/**
+ * brief the termios speeds, the other baudrates are rejected
+ */
+static const UartSpeed_t UartSpeeds[] =
+{
+  { 1200, B1200 }, { 2400, B2400 }, { 4800, B4800 }, { 9600, B9600 },
+  { 19200, B19200 }, { 38400, B38400 }, { 57600, B57600 },
+  { 115200, B115200 }, { 230400, B230400 }, { 460800, B460800 },
+  { 500000, B500000 }, { 576000, B576000 }, { 921600, B921600 },
+  { 1000000, B1000000 }, { 1500000, B1500000 }, { 2000000, B2000000 },
+  { 3000000, B3000000 }, { 4000000, B4000000 }
+};
+
+/**
+ * brief the termios character sizes indexed by UartDataBits_t
+ */
+static const tcflag_t UartCharSizes[] = { CS5, CS6, CS7, CS8 };
+
+#if (UART_EPOLL == 1)
+/**
+ * brief the epoll instance of the event loop, -1 if it isn't created
+ */
+static int UartEpollFd = -1;
+
+/**
+ * brief the hook called after bytes are received, 0x00 if none
+ */
+static UartReceiveHandler_t UartReceiveHandler;
+
+/**
+ * brief the channels to flush and re-arm before the next wait, a bit per
+ * channel set by the send and receive APIs
+ */
+static uint32_t UartEpollPending[(UART_MAX + 31) / 32];
+
+#define UART_EPOLL_MARK(Uart) \
+  (UartEpollPending[(Uart) / 32] |= (uint32_t) 1 << ((Uart) % 32))
+#else
+#define UART_EPOLL_MARK(Uart) ((void) 0)
+#endif
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+static uint8_t Uart_ApplyConfig(const int Fd, const UartConfig_t * const Config);
+static uint8_t Uart_OutputIdle(const UartChannel_t * const Channel);
+static uint8_t Uart_SwitchConfig(const Uart_t Uart, UartChannel_t * const Channel,
+  const UartConfig_t * const Config);
+static uint8_t Uart_ReceiveOverflow(const Uart_t Uart, UartChannel_t * const Channel);
+static void Uart_SendChannel(const Uart_t Uart, UartChannel_t * const Channel);
+static uint8_t Uart_ReceiveChannel(const Uart_t Uart, UartChannel_t * const Channel);
+static inline void Uart_ReceiveResume(const Uart_t Uart);
+#if (UART_EPOLL == 1)
+static void Uart_EpollArm(const Uart_t Uart, UartChannel_t * const Channel);
+static void Uart_EpollService(const Uart_t Uart, const uint32_t Events);
+static void Uart_EpollFlush(void);
+#endif
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+/******************************************************************************
+* Function : Uart_ApplyConfig()
+*//**
+* \b Description:
+* Utility function is used to set a tty up as a raw line (no echo, no line
+* editing, no character translation) with the baudrate, the frame format
+* and the flow control of a configuration. The reads never wait (VMIN and
+* VTIME are 0).
+*
+* @param Fd the tty file descriptor
+* @param Config a valid pointer to the configuration
+* @return uint8_t 1 if the tty is set up, 0 otherwise
+*
+* @see Uart_Init
+* @see Uart_Reconfigure
+*******************************************************************************/
+static uint8_t
+Uart_ApplyConfig(const int Fd, const UartConfig_t * const Config)
+{
+  struct termios Tty;
+  speed_t Speed = B0;
+
+  for(uint8_t i = 0; i < sizeof(UartSpeeds) / sizeof(UartSpeeds[0]); i++)
+    {
+      if(UartSpeeds[i].Baudrate == Config->Baudrate) Speed = UartSpeeds[i].Speed;
+    }
+
+  if(Speed == B0 || Config->DataBits > UART_DATA_BITS_8) return 0;
+  if(tcgetattr(Fd, &Tty) != 0) return 0;
+
+  cfmakeraw(&Tty);
+  Tty.c_cflag &= (tcflag_t) ~(CSIZE | CSTOPB | PARENB | PARODD | CRTSCTS);
+  Tty.c_cflag |= UartCharSizes[Config->DataBits] | CLOCAL | CREAD;
+  Tty.c_iflag &= (tcflag_t) ~(IXON | IXOFF | IXANY | INPCK);
+
+  if(Config->StopBit == UART_STOP_BIT_2) Tty.c_cflag |= CSTOPB;
+
+  if(Config->Parity != UART_PARTIY_NO)
+    {
+      Tty.c_cflag |= PARENB;
+      Tty.c_iflag |= INPCK;
+      if(Config->Parity == UART_PARTIY_ODD) Tty.c_cflag |= PARODD;
+    }
+
+  if(Config->FlowControl == UART_FLOW_CONTROL_RTS_CTS) Tty.c_cflag |= CRTSCTS;
+  else if(Config->FlowControl == UART_FLOW_CONTROL_XON_XOFF) Tty.c_iflag |= IXON | IXOFF;
+
+  Tty.c_cc[VMIN] = 0;
+  Tty.c_cc[VTIME] = 0;
+
+  if(cfsetispeed(&Tty, Speed) != 0 || cfsetospeed(&Tty, Speed) != 0) return 0;
+
+  return (tcsetattr(Fd, TCSANOW, &Tty) == 0) ? 1 : 0;
+}
+
+/******************************************************************************
+* Function : Uart_OutputIdle()
+*//**
+* \b Description:
+* Utility function is used to check that every byte queued before the
+* pending configuration of a channel left the host: the send buffer is sent
+* up to PendingConfigPos and the tty output queue is empty. It never waits,
+* unlike tcdrain(3).
+*
+* @param Channel a valid pointer to the channel control block
+* @return uint8_t 1 if the output is idle, 0 otherwise
+*
+* @see Uart_Reconfigure
+*******************************************************************************/
+static uint8_t
+Uart_OutputIdle(const UartChannel_t * const Channel)
+{
+  int Queued = 0;
+
+  if(Channel->SendBuff.State.Rear != Channel->PendingConfigPos) return 0;
+  if(ioctl(Channel->Fd, TIOCOUTQ, &Queued) != 0) return 1;
+
+  return (Queued == 0) ? 1 : 0;
+}
+
+/******************************************************************************
+* Function : Uart_SwitchConfig()
+*//**
+* \b Description:
+* Utility function is used to apply a configuration to the tty of an open
+* channel, a failure is reported (UART_E_IO) and the channel keeps its
+* configuration.
+*
+* @param Uart the Uart Id
+* @param Channel a valid pointer to the channel control block
+* @param Config a valid pointer to the new configuration
+* @return uint8_t 1 if the configuration is applied, 0 otherwise
+*
+* @see Uart_Reconfigure
+*******************************************************************************/
+static uint8_t
+Uart_SwitchConfig(const Uart_t Uart, UartChannel_t * const Channel,
+  const UartConfig_t * const Config)
+{
+  if(Uart_ApplyConfig(Channel->Fd, Config) == 0)
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECONFIGURE_ID, UART_E_IO);
+      return 0;
+    }
+
+  Channel->Config = Config;
+  Channel->ReceiveBuff.State.Policy = (uint8_t) Config->ReceivePolicy;
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveOverflow()
+*//**
+* \b Description:
+* Utility function is used when the receive buffer is full and flow control
+* is off, the waiting bytes are read and enqueued one by one so the receive
+* policy applies to them like on the firmware targets. With flow control on
+* they are left in the tty input queue and the tty driver holds the peer off.
+*
+* @param Uart the Uart Id
+* @param Channel a valid pointer to the channel control block
+* @return uint8_t 1 if bytes are read, 0 otherwise
+*
+* @see Uart_ReceiveChannel
+*******************************************************************************/
+static uint8_t
+Uart_ReceiveOverflow(const Uart_t Uart, UartChannel_t * const Channel)
+{
+  uint8_t Data[UART_BUFF_SIZE];
+  uint8_t Dropped = 0;
+  ssize_t Length = read(Channel->Fd, Data, sizeof(Data));
+
+  for(ssize_t i = 0; i < Length; i++)
+    {
+      if(CircBuff_Enqueue(&Channel->ReceiveBuff, Data[i]) == 0) Dropped = 1;
+    }
+
+  if(Dropped == 1 && Channel->Config->ReceivePolicy == CIRCBUFF_REPORT)
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_RX_OVERFLOW);
+    }
+
+  return (Length > 0) ? 1 : 0;
+}
+
+/******************************************************************************
+* Function : Uart_SendChannel()
+*//**
+* \b Description:
+* Utility function is used to write the send buffer of an open channel to
+* its tty with a single writev(2) of its two runs, the bytes the tty took
+* are removed. While a configuration is deferred only the bytes queued
+* before it are written, it's applied once they left the host.
+*
+* @param Uart the Uart Id
+* @param Channel a valid pointer to the channel control block
+* @return void
+*
+* @see Uart_SendUpdate
+* @see Uart_EpollWait
+*******************************************************************************/
+static void
+Uart_SendChannel(const Uart_t Uart, UartChannel_t * const Channel)
+{
+  CircBuffRegion_t Regions[2];
+  uint8_t Length = CircBuff_ReadRegions(&Channel->SendBuff, Regions);
+
+  //the bytes queued after a deferred configuration wait for it
+  if(Channel->PendingConfig != 0x00)
+    {
+      Length = CircBuff_Distance(Channel->SendBuff.State.Rear,
+        Channel->PendingConfigPos, UART_BUFF_SIZE);
+
+      if(Regions[0].Length > Length) Regions[0].Length = Length;
+      Regions[1].Length = (uint8_t) (Length - Regions[0].Length);
+    }
+
+  if(Length != 0)
+    {
+      struct iovec Vectors[2] =
+      {
+        { Regions[0].Data, Regions[0].Length },
+        { Regions[1].Data, Regions[1].Length }
+      };
+      ssize_t Written = writev(Channel->Fd, Vectors, (Regions[1].Length != 0) ? 2 : 1);
+
+      if(Written < 0)
+        {
+          if(errno != EAGAIN && errno != EINTR)
+            {
+              Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_UPDATE_ID, UART_E_IO);
+            }
+          return;
+        }
+
+      CircBuff_Skip(&Channel->SendBuff, (uint8_t) Written);
+    }
+
+  if(Channel->PendingConfig != 0x00 && Uart_OutputIdle(Channel) == 1)
+    {
+      Uart_SwitchConfig(Uart, Channel, Channel->PendingConfig);
+      Channel->PendingConfig = 0x00;
+    }
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveChannel()
+*//**
+* \b Description:
+* Utility function is used to read the waiting bytes of the tty of an open
+* channel into its receive buffer with a single readv(2) of the two free
+* runs.
+*
+* @param Uart the Uart Id
+* @param Channel a valid pointer to the channel control block
+* @return uint8_t 1 if bytes are read, 0 otherwise
+*
+* @see Uart_ReceiveUpdate
+* @see Uart_EpollWait
+*******************************************************************************/
+static uint8_t
+Uart_ReceiveChannel(const Uart_t Uart, UartChannel_t * const Channel)
+{
+  CircBuffRegion_t Regions[2];
+  uint8_t Length = CircBuff_WriteRegions(&Channel->ReceiveBuff, Regions);
+
+  if(Length == 0)
+    {
+      if(Channel->Config->FlowControl != UART_FLOW_CONTROL_NONE) return 0;
+
+      return Uart_ReceiveOverflow(Uart, Channel);
+    }
+
+  struct iovec Vectors[2] =
+  {
+    { Regions[0].Data, Regions[0].Length },
+    { Regions[1].Data, Regions[1].Length }
+  };
+  ssize_t Read = readv(Channel->Fd, Vectors, (Regions[1].Length != 0) ? 2 : 1);
+
+  if(Read < 0)
+    {
+      if(errno != EAGAIN && errno != EINTR)
+        {
+          Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_IO);
+        }
+      return 0;
+    }
+
+  CircBuff_CommitWrite(&Channel->ReceiveBuff, (uint8_t) Read);
+
+  return (Read > 0) ? 1 : 0;
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveResume()
+*//**
+* \b Description:
+* Utility function is used after bytes are taken from the receive buffer, a
+* channel whose EPOLLIN is off for a full buffer is re-armed before the next
+* wait. It does nothing without the event loop.
+*
+* @param Uart the Uart Id
+* @return void
+*
+* @see Uart_EpollArm
+*******************************************************************************/
+static inline void
+Uart_ReceiveResume(const Uart_t Uart)
+{
+#if (UART_EPOLL == 1)
+  if(UartChannels[Uart].RxPaused == 1) UART_EPOLL_MARK(Uart);
+#else
+  (void) Uart;
+#endif
+}
+
+#if (UART_EPOLL == 1)
+/******************************************************************************
+* Function : Uart_EpollArm()
+*//**
+* \b Description:
+* Utility function is used to register a channel for the events it waits
+* for: EPOLLOUT while the send buffer holds bytes it can write, EPOLLIN
+* unless the receive buffer is full and flow control holds the peer off. The
+* tty is only modified when the events change.
+*
+* @param Uart the Uart Id
+* @param Channel a valid pointer to the channel control block
+* @return void
+*
+* @see Uart_EpollWait
+*******************************************************************************/
+static void
+Uart_EpollArm(const Uart_t Uart, UartChannel_t * const Channel)
+{
+  uint32_t Events = EPOLLERR;
+
+  Channel->RxPaused = (Channel->Config->FlowControl != UART_FLOW_CONTROL_NONE &&
+    CircBuff_Count(&Channel->ReceiveBuff) == UART_BUFF_SIZE - 1) ? 1 : 0;
+
+  if(Channel->RxPaused == 0) Events |= EPOLLIN;
+
+  if(Channel->PendingConfig != 0x00)
+    {
+      //the bytes queued after a deferred configuration can't be written yet
+      if(Channel->SendBuff.State.Rear != Channel->PendingConfigPos) Events |= EPOLLOUT;
+
+      //no event tells the tty output queue drained, poll it on every wait
+      UART_EPOLL_MARK(Uart);
+    }
+  else if(CircBuff_Count(&Channel->SendBuff) != 0)
+    {
+      Events |= EPOLLOUT;
+    }
+
+  if(Events == Channel->EpollEvents) return;
+
+  struct epoll_event Event = { .events = Events, .data.u32 = Uart };
+
+  if(epoll_ctl(UartEpollFd, EPOLL_CTL_MOD, Channel->Fd, &Event) != 0)
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_EPOLL_WAIT_ID, UART_E_IO);
+      return;
+    }
+
+  Channel->EpollEvents = Events;
+}
+
+/******************************************************************************
+* Function : Uart_EpollService()
+*//**
+* \b Description:
+* Utility function is used to update a registered channel for its readiness
+* events and re-arm it. A hung up or failed tty is reported (UART_E_IO) and
+* removed from the event loop, the bytes it had waiting are read first.
+*
+* @param Uart the Uart Id
+* @param Events the ready events, EPOLLOUT for a flush before the wait
+* @return void
+*
+* @see Uart_EpollWait
+*******************************************************************************/
+static void
+Uart_EpollService(const Uart_t Uart, const uint32_t Events)
+{
+  UartChannel_t * const Channel = &UartChannels[Uart];
+
+  if(Channel->EpollEvents == 0) return;
+
+  if((Events & EPOLLOUT) != 0) Uart_SendChannel(Uart, Channel);
+
+  if((Events & EPOLLIN) != 0 && Uart_ReceiveChannel(Uart, Channel) == 1 &&
+    UartReceiveHandler != 0x00)
+    {
+      UartReceiveHandler(Uart);
+    }
+
+  if((Events & (EPOLLERR | EPOLLHUP)) != 0)
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_EPOLL_WAIT_ID, UART_E_IO);
+      epoll_ctl(UartEpollFd, EPOLL_CTL_DEL, Channel->Fd, 0x00);
+      Channel->EpollEvents = 0;
+      return;
+    }
+
+  Uart_EpollArm(Uart, Channel);
+}
+
+/******************************************************************************
+* Function : Uart_EpollFlush()
+*//**
+* \b Description:
+* Utility function is used to flush and re-arm the channels marked by the
+* send and receive APIs, most sends leave here without waiting for EPOLLOUT.
+*
+* @return void
+*
+* @see Uart_EpollWait
+*******************************************************************************/
+static void
+Uart_EpollFlush(void)
+{
+  for(uint8_t Word = 0; Word < sizeof(UartEpollPending) / sizeof(UartEpollPending[0]); Word++)
+    {
+      uint32_t Pending = UartEpollPending[Word];
+
+      //the flush may mark the channel again, it's serviced on the next flush
+      UartEpollPending[Word] = 0;
+
+      while(Pending != 0)
+        {
+          Uart_t Uart = (Uart_t) (Word * 32 + __builtin_ctz(Pending));
+
+          Pending &= Pending - 1;
+          Uart_EpollService(Uart, EPOLLOUT);
+        }
+    }
+}
+#endif
+
+/******************************************************************************
+* Function : Uart_Init()
+*//**
+* \b Description:
+* This function is used to open and set up the tty of every channel based on
+* the configuration table defined in uart_cfg file. A channel whose tty can't
+* be opened or set up is reported (UART_E_IO) and stays closed, its updates
+* do nothing. <br>
+* PRE-CONDITION: Configuration table needs to populated (sizeof > 0) <br>
+* POST-CONDITION: The ttys are open non-blocking and set up with the
+* configuration settings.<br>
+* @param Config is a pointer to the configuration table that
+* contains the initialization for the channels.
+* @return void
+*
+* \b Example:
+* @code
+* const UartConfig_t *UartConfig = Uart_GetConfig();
+* Uart_Init(UartConfig);
+* @endcode
+* @see Uart_GetConfig
+* @see Uart_Deinit
+*******************************************************************************/
+extern void
+Uart_Init(const UartConfig_t * const Config)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Config != 0x00))
+    {
+      Det_ReportError(UART_MODULE_ID, 0, UART_INIT_ID, UART_E_PARAM);
+      return;
+    }
+#endif
+
+  for(uint8_t i = 0; i < UART_MAX; i++)
+    {
+      UartChannel_t * const Channel = &UartChannels[i];
+
+      //the descriptor of a channel set up by a previous Uart_Init
+      if(Channel->Config != 0x00 && Channel->Fd >= 0) close(Channel->Fd);
+
+      Channel->SendBuff = CircBuff_Create(UartSendData[i], UART_BUFF_SIZE);
+      Channel->ReceiveBuff = CircBuff_CreatePolicy(UartReceiveData[i],
+        UART_BUFF_SIZE, Config[i].ReceivePolicy);
+      Channel->Config = &Config[i];
+      Channel->PendingConfig = 0x00;
+#if (UART_EPOLL == 1)
+      Channel->EpollEvents = 0;
+      Channel->RxPaused = 0;
+#endif
+
+      Channel->Fd = open(Config[i].Device, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+
+      if(Channel->Fd >= 0 && Uart_ApplyConfig(Channel->Fd, &Config[i]) == 0)
+        {
+          close(Channel->Fd);
+          Channel->Fd = -1;
+        }
+
+      if(Channel->Fd < 0)
+        {
+          Det_ReportError(UART_MODULE_ID, i, UART_INIT_ID, UART_E_IO);
+        }
+    }
+}
+
+/******************************************************************************
+* Function : Uart_Deinit()
+*//**
+* \b Description:
+* This function is used to close the tty of every channel and the event
+* loop, the bytes still in the send buffers are discarded. <br>
+* @return void
+*
+* @see Uart_Init
+* @see Uart_EpollInit
+*******************************************************************************/
+extern void
+Uart_Deinit(void)
+{
+  for(uint8_t i = 0; i < UART_MAX; i++)
+    {
+      if(UartChannels[i].Config != 0x00 && UartChannels[i].Fd >= 0)
+        {
+          close(UartChannels[i].Fd);
+        }
+
+      UartChannels[i].Fd = -1;
+#if (UART_EPOLL == 1)
+      UartChannels[i].EpollEvents = 0;
+#endif
+    }
+
+#if (UART_EPOLL == 1)
+  if(UartEpollFd >= 0) close(UartEpollFd);
+
+  UartEpollFd = -1;
+#endif
+}
+
+/******************************************************************************
+* Function : Uart_Reconfigure()
+*//**
+* \b Description:
+* This function is used to change the baudrate, the frame format or the flow
+* control of a channel at runtime. The new configuration is applied at once
+* if every byte left the host, otherwise it's deferred and applied by
+* Uart_SendUpdate (or Uart_EpollWait) once the bytes queued before this call
+* left the host, the bytes queued after it wait for it. So no byte is sent
+* with a mixed format. A second call before the first configuration is
+* applied replaces it. The Device of Config is not used, the channel keeps
+* its tty. <br>
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @param Config a pointer to the new configuration, it must stay valid
+* @return uint8_t 1 if the configuration is applied, 0 if it's deferred or
+* rejected
+*
+* @see Uart_SendUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_Reconfigure(const Uart_t Uart, const UartConfig_t * const Config)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Config != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECONFIGURE_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[Uart];
+
+  if(Channel->Fd < 0) return 0;
+
+  Channel->PendingConfig = Config;
+  Channel->PendingConfigPos = Channel->SendBuff.State.Front;
+
+  if(Uart_OutputIdle(Channel) == 0)
+    {
+      UART_EPOLL_MARK(Uart);
+      return 0;
+    }
+
+  Channel->PendingConfig = 0x00;
+
+  return Uart_SwitchConfig(Uart, Channel, Config);
+}
+
+/******************************************************************************
+* Function : Uart_GetFd()
+*//**
+* \b Description:
+* This function is used to get the tty file descriptor of a channel, e.g. to
+* wait for it with poll(2) before calling the updates. The descriptor is
+* owned by the driver and must not be read, written or closed. <br>
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @return int the file descriptor, -1 if the channel isn't open
+*
+* \b Example:
+* @code
+* struct pollfd Poll = { Uart_GetFd(UART_0), POLLIN, 0 };
+* if(poll(&Poll, 1, 10) > 0) Uart_ReceiveUpdate(UART_0);
+* @endcode
+*******************************************************************************/
+extern int
+Uart_GetFd(const Uart_t Uart)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_GET_FD_ID, UART_E_PARAM);
+      return -1;
+    }
+#endif
+
+  return UartChannels[Uart].Fd;
+}
+
+/******************************************************************************
+* Function : Uart_SendUpdate()
+*//**
+* \b Description:
+* This function is used to write the send buffer to the tty. The buffer is
+* at most two contiguous runs, both are written by a single writev(2) and
+* removed as far as the tty took them. It never waits, the bytes the tty
+* output queue has no room for stay in the send buffer. <br>
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @return void
+*
+* @see Uart_SendString
+*******************************************************************************/
+extern void
+Uart_SendUpdate(const Uart_t Uart)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_UPDATE_ID, UART_E_PARAM);
+      return;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[Uart];
+
+  if(Channel->Fd < 0) return;
+
+  Uart_SendChannel(Uart, Channel);
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveUpdate()
+*//**
+* \b Description:
+* This function is used to read the waiting bytes of the tty into the
+* receive buffer. The free space is at most two contiguous runs, both are
+* filled by a single readv(2). It never waits. <br>
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @return void
+*
+* @see Uart_ReceiveString
+*******************************************************************************/
+extern void
+Uart_ReceiveUpdate(const Uart_t Uart)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_UPDATE_ID, UART_E_PARAM);
+      return;
+    }
+#endif
+
+  UartChannel_t * const Channel = &UartChannels[Uart];
+
+  if(Channel->Fd < 0) return;
+
+  Uart_ReceiveChannel(Uart, Channel);
+}
+
+/******************************************************************************
+* Function : Uart_ServiceAll()
+*//**
+* \b Description:
+* This function is used to update every open channel, the send updates
+* first. It's the polled counterpart of waiting for the descriptors of
+* Uart_GetFd with poll(2). <br>
+* PRE-CONDITION: Uart_Init called properly <br>
+* @return void
+*
+* @see Uart_SendUpdate
+* @see Uart_ReceiveUpdate
+*******************************************************************************/
+extern void
+Uart_ServiceAll(void)
+{
+  for(uint8_t i = 0; i < UART_MAX; i++)
+    {
+      if(UartChannels[i].Fd < 0) continue;
+
+      Uart_SendUpdate((Uart_t) i);
+      Uart_ReceiveUpdate((Uart_t) i);
+    }
+}
+
+/******************************************************************************
+* Function : Uart_SendByte()
+*//**
+* \b Description:
+* This function is used to store a byte in the UART send data buffers so it can
+* be sent later when Uart_SendUpdate is called
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @param Data the byte to store
+* @return uint8_t 1 if the byte is stored and 0 otherwise.
+*
+* @see Uart_SendUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_SendByte(const Uart_t Uart, const uint8_t Data)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_BYTE_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  uint8_t Stored = CircBuff_Enqueue(&UartChannels[Uart].SendBuff, Data);
+
+  if(Stored != 0) UART_EPOLL_MARK(Uart);
+
+  return Stored;
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveByte()
+*//**
+* \b Description:
+* This function is used to receive the next byte from the UART receive data buffers.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @param Data a pointer to store the received byte
+* @return uint8_t 1 if the byte is received and 0 otherwise.
+*
+* @see Uart_ReceiveUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_ReceiveByte(const Uart_t Uart, uint8_t* const Data)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_BYTE_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  Uart_ReceiveResume(Uart);
+
+  return CircBuff_Dequeue(&UartChannels[Uart].ReceiveBuff, Data);
+}
+
+/******************************************************************************
+* Function : Uart_SendString()
+*//**
+* \b Description:
+* This function is used to store a string in the UART send data buffers so it can
+* be sent later when Uart_SendUpdate is called
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @param Data a pointer to the data to store in send data buffers
+* @param DataSize The size of the string to send
+* @return uint8_t the number of stored data in bytes
+*
+* @see Uart_SendUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_SendString(
+  const Uart_t Uart,
+  const uint8_t * const Data,
+  const uint8_t DataSize)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SEND_STRING_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  uint8_t Stored = CircBuff_EnqueueBulk(&UartChannels[Uart].SendBuff, Data, DataSize);
+
+  if(Stored != 0) UART_EPOLL_MARK(Uart);
+
+  return Stored;
+}
+
+/******************************************************************************
+* Function : Uart_ReceiveString()
+*//**
+* \b Description:
+* This function is used to receive a string from the UART receive data buffers.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @param Data a pointer to store the received string in
+* @param DataSize The size of the string to receive
+* @return uint8_t the number of received data in bytes
+*
+* @see Uart_ReceiveUpdate
+*******************************************************************************/
+extern uint8_t
+Uart_ReceiveString(
+  const Uart_t Uart,
+  uint8_t * const Data,
+  const uint8_t DataSize)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_RECEIVE_STRING_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  Uart_ReceiveResume(Uart);
+
+  return CircBuff_DequeueBulk(&UartChannels[Uart].ReceiveBuff, Data, DataSize);
+}
+
+/******************************************************************************
+* Function : Uart_PeekLastByte()
+*//**
+* \b Description:
+* This function is used to peek the last received byte without removing it
+* from the UART receive data buffers.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @param Data a pointer to store the byte in
+* @return uint8_t 1 if the byte is stored and 0 otherwise.
+*
+* @see Uart_PeekByte
+*******************************************************************************/
+extern uint8_t
+Uart_PeekLastByte(const Uart_t Uart, uint8_t* const Data)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_PEEK_LAST_BYTE_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  return CircBuff_PeekLast(&UartChannels[Uart].ReceiveBuff, Data);
+}
+
+/******************************************************************************
+* Function : Uart_PeekByte()
+*//**
+* \b Description:
+* This function is used to read a received byte without removing it from the
+* UART receive data buffers. Offset 0 is the next byte Uart_ReceiveByte
+* returns.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @param Offset the position of the byte from the oldest received one
+* @param Data a pointer to store the byte in
+* @return uint8_t 1 if the byte is stored and 0 if fewer bytes are received.
+*
+* @see Uart_PeekString
+*******************************************************************************/
+extern uint8_t
+Uart_PeekByte(const Uart_t Uart, const uint8_t Offset, uint8_t* const Data)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_PEEK_BYTE_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  return CircBuff_PeekAt(&UartChannels[Uart].ReceiveBuff, Offset, Data);
+}
+
+/******************************************************************************
+* Function : Uart_PeekString()
+*//**
+* \b Description:
+* This function is used to copy received bytes without removing them from the
+* UART receive data buffers.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @param Data a pointer to store the bytes in
+* @param Offset the position of the first byte from the oldest received one
+* @param DataSize the number of bytes to peek
+* @return uint8_t the number of peeked bytes
+*
+* @see Uart_Skip
+*******************************************************************************/
+extern uint8_t
+Uart_PeekString(
+  const Uart_t Uart,
+  uint8_t * const Data,
+  const uint8_t Offset,
+  const uint8_t DataSize)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Data != 0x00 && Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_PEEK_STRING_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  return CircBuff_PeekSpan(&UartChannels[Uart].ReceiveBuff, Data, Offset, DataSize);
+}
+
+/******************************************************************************
+* Function : Uart_FindByte()
+*//**
+* \b Description:
+* This function is used to search the UART receive data buffers for a byte
+* without removing anything.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @param Data the byte to search for
+* @param Offset the position to start the search at from the oldest received
+* byte
+* @return uint8_t the position of the first match from the oldest received
+* byte, CIRCBUFF_NOT_FOUND if the byte is not received yet
+*
+* @see Uart_Skip
+*******************************************************************************/
+extern uint8_t
+Uart_FindByte(const Uart_t Uart, const uint8_t Data, const uint8_t Offset)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_FIND_BYTE_ID, UART_E_PARAM);
+      return CIRCBUFF_NOT_FOUND;
+    }
+#endif
+
+  return CircBuff_Find(&UartChannels[Uart].ReceiveBuff, Data, Offset);
+}
+
+/******************************************************************************
+* Function : Uart_Skip()
+*//**
+* \b Description:
+* This function is used to discard the oldest received bytes from the UART
+* receive data buffers.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @param Count the number of bytes to discard
+* @return uint8_t the number of discarded bytes
+*
+* @see Uart_PeekString
+* @see Uart_FindByte
+*******************************************************************************/
+extern uint8_t
+Uart_Skip(const Uart_t Uart, const uint8_t Count)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_SKIP_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  Uart_ReceiveResume(Uart);
+
+  return CircBuff_Skip(&UartChannels[Uart].ReceiveBuff, Count);
+}
+
+/******************************************************************************
+* Function : Uart_GetReceiveLost()
+*//**
+* \b Description:
+* This function is used to get the number of received bytes that were
+* overwritten (CIRCBUFF_OVERWRITE_OLDEST) or discarded (CIRCBUFF_REPORT)
+* because the receive buffer was full.
+* PRE-CONDITION: Uart_Init called properly <br>
+* @param Uart the Uart Id
+* @return uint16_t the number of lost bytes
+*
+* @see Uart_ReceiveUpdate
+*******************************************************************************/
+extern uint16_t
+Uart_GetReceiveLost(const Uart_t Uart)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(Uart < UART_MAX))
+    {
+      Det_ReportError(UART_MODULE_ID, Uart, UART_GET_RECEIVE_LOST_ID, UART_E_PARAM);
+      return 0;
+    }
+#endif
+
+  return CircBuff_GetLost(&UartChannels[Uart].ReceiveBuff);
+}
+
+#if (UART_EPOLL == 1)
+/******************************************************************************
+* Function : Uart_EpollInit()
+*//**
+* \b Description:
+* This function is used to create the event loop and register the tty of
+* every open channel for EPOLLIN. Uart_EpollWait then services only the
+* channels the kernel reports ready instead of updating every channel like
+* Uart_ServiceAll, so the cost of a wait follows the active channels, not
+* UART_MAX. <br>
+* PRE-CONDITION: Uart_Init called properly <br>
+* POST-CONDITION: The open channels are registered <br>
+* @param Handler the hook called after bytes are received on a channel,
+* 0x00 if none
+* @return uint8_t 1 if the event loop is created, 0 otherwise
+*
+* \b Example:
+* @code
+* Uart_Init(Uart_GetConfig());
+* Uart_EpollInit(Protocol_Parse);
+* while(1) Uart_EpollWait(-1);
+* @endcode
+* @see Uart_EpollWait
+* @see Uart_Deinit
+*******************************************************************************/
+extern uint8_t
+Uart_EpollInit(const UartReceiveHandler_t Handler)
+{
+  if(UartEpollFd >= 0) close(UartEpollFd);
+
+  UartEpollFd = epoll_create1(EPOLL_CLOEXEC);
+
+  if(UartEpollFd < 0)
+    {
+      Det_ReportError(UART_MODULE_ID, 0, UART_EPOLL_INIT_ID, UART_E_IO);
+      return 0;
+    }
+
+  UartReceiveHandler = Handler;
+
+  for(uint8_t i = 0; i < UART_MAX; i++)
+    {
+      UartChannel_t * const Channel = &UartChannels[i];
+      struct epoll_event Event = { .events = EPOLLIN | EPOLLERR, .data.u32 = i };
+
+      Channel->EpollEvents = 0;
+      Channel->RxPaused = 0;
+
+      if(Channel->Fd < 0) continue;
+
+      if(epoll_ctl(UartEpollFd, EPOLL_CTL_ADD, Channel->Fd, &Event) != 0)
+        {
+          Det_ReportError(UART_MODULE_ID, i, UART_EPOLL_INIT_ID, UART_E_IO);
+          continue;
+        }
+
+      Channel->EpollEvents = Event.events;
+
+      //flush what was queued before the event loop
+      UART_EPOLL_MARK(i);
+    }
+
+  return 1;
+}
+
+/******************************************************************************
+* Function : Uart_EpollWait()
+*//**
+* \b Description:
+* This function is used to run one round of the event loop. The channels
+* marked by the send and receive APIs are flushed and re-armed first, then
+* it waits for readiness events: EPOLLIN reads the tty and calls the receive
+* hook, EPOLLOUT writes the rest of the send buffer. The replies the hook
+* queued are flushed before returning. At most UART_EPOLL_EVENTS channels
+* are serviced per call, the others stay ready for the next one. While a
+* deferred reconfiguration waits for a tty output queue to drain, the wait
+* is at most UART_EPOLL_DRAIN_MS so it's applied without another event. <br>
+* PRE-CONDITION: Uart_EpollInit called properly <br>
+* @param Timeout the longest wait in milliseconds, -1 to wait forever and 0
+* to never wait
+* @return int the number of serviced events, -1 if the event loop isn't
+* created
+*
+* @see Uart_EpollInit
+*******************************************************************************/
+extern int
+Uart_EpollWait(const int Timeout)
+{
+#if (UART_DEV_ERROR_DETECT == 1)
+  if(!(UartEpollFd >= 0))
+    {
+      Det_ReportError(UART_MODULE_ID, 0, UART_EPOLL_WAIT_ID, UART_E_PARAM);
+      return -1;
+    }
+#endif
+
+  struct epoll_event Events[UART_EPOLL_EVENTS];
+  int Wait = Timeout;
+
+  Uart_EpollFlush();
+
+  //the channels still marked poll their tty output queue
+  for(uint8_t Word = 0; Word < sizeof(UartEpollPending) / sizeof(UartEpollPending[0]); Word++)
+    {
+      if(UartEpollPending[Word] != 0 && (Wait < 0 || Wait > UART_EPOLL_DRAIN_MS))
+        {
+          Wait = UART_EPOLL_DRAIN_MS;
+        }
+    }
+
+  int Count = epoll_wait(UartEpollFd, Events, UART_EPOLL_EVENTS, Wait);
+
+  if(Count < 0)
+    {
+      if(errno != EINTR)
+        {
+          Det_ReportError(UART_MODULE_ID, 0, UART_EPOLL_WAIT_ID, UART_E_IO);
+        }
+      return 0;
+    }
+
+  for(int i = 0; i < Count; i++)
+    {
+      Uart_EpollService((Uart_t) Events[i].data.u32, Events[i].events);
+    }
+
+  Uart_EpollFlush();
+
+  return Count;
+}
+#endif
+
+/*****************************End of File ************************************/
@@ -0,0 +1,104 @@
+/**
+ * @file uart.h
+ * @author Mohamed Hassanin
+ * @brief A UART driver header file for Linux hosts. It's the uart.h API of
+ * the firmware targets over tty file descriptors, the 9-bit, addressed bus,
+ * half-duplex and autobaud services have no tty counterpart and are left out.
+ * @version 0.1
+ * @date 2021-03-20
+ */
+#ifndef UART_H
+#define UART_H
+
+/******************************************************************************
+ * typedefs
+ ******************************************************************************/
+
+/**
+ * @brief A service id for error handling
+ */
+typedef enum
+{
+  UART_INIT_ID,
+  UART_SEND_UPDATE_ID,
+  UART_RECEIVE_UPDATE_ID,
+  UART_SEND_BYTE_ID,
+  UART_RECEIVE_BYTE_ID,
+  UART_SEND_STRING_ID,
+  UART_RECEIVE_STRING_ID,
+  UART_PEEK_LAST_BYTE_ID,
+  UART_GET_RECEIVE_LOST_ID,
+  UART_RECONFIGURE_ID,
+  UART_PEEK_BYTE_ID,
+  UART_PEEK_STRING_ID,
+  UART_FIND_BYTE_ID,
+  UART_SKIP_ID,
+  UART_GET_FD_ID,
+  UART_DEINIT_ID,
+  UART_EPOLL_INIT_ID,
+  UART_EPOLL_WAIT_ID
+} UartServiceId_t;
+
+/**
+ * @brief types of possible realtime errors
+ */
+typedef enum
+{
+  UART_E_PARAM, /**< An invalid parameter passed to a function */
+  UART_E_RX_OVERFLOW, /**< receive buffer full (CIRCBUFF_REPORT policy) */
+  UART_E_IO, /**< the tty device can't be opened, set up, read or written */
+  UART_E_MAX /**< the number of errors, the size of the Det error table */
+} UartError_t;
+
+/******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <inttypes.h>
+#include "uart_cfg.h"
+/******************************************************************************
+ * typedefs
+ ******************************************************************************/
+/**
+ * @brief A hook called by Uart_EpollWait after bytes are received on a
+ * channel, e.g. to run the protocol parser of the channel
+ */
+typedef void (*UartReceiveHandler_t)(const Uart_t Uart);
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern void Uart_Init(const UartConfig_t * const Config);
+extern void Uart_Deinit(void);
+extern uint8_t Uart_Reconfigure(const Uart_t Uart, const UartConfig_t * const Config);
+extern int Uart_GetFd(const Uart_t Uart);
+
+extern void Uart_SendUpdate(const Uart_t Uart);
+extern void Uart_ReceiveUpdate(const Uart_t Uart);
+extern void Uart_ServiceAll(void);
+
+extern uint8_t Uart_SendByte(const Uart_t Uart, const uint8_t Data);
+extern uint8_t Uart_ReceiveByte(const Uart_t Uart, uint8_t* const Data);
+extern uint8_t Uart_PeekLastByte(const Uart_t Uart, uint8_t* const Data);
+extern uint8_t Uart_PeekByte(const Uart_t Uart, const uint8_t Offset, uint8_t* const Data);
+extern uint8_t Uart_PeekString(const Uart_t Uart, uint8_t * const Data, const uint8_t Offset, const uint8_t DataSize);
+extern uint8_t Uart_FindByte(const Uart_t Uart, const uint8_t Data, const uint8_t Offset);
+extern uint8_t Uart_Skip(const Uart_t Uart, const uint8_t Count);
+extern uint16_t Uart_GetReceiveLost(const Uart_t Uart);
+
+extern uint8_t Uart_SendString(const Uart_t Uart, const uint8_t * const Data, const uint8_t DataSize);
+extern uint8_t Uart_ReceiveString(const Uart_t Uart, uint8_t * const Data, const uint8_t DataSize);
+
+#if (UART_EPOLL == 1)
+extern uint8_t Uart_EpollInit(const UartReceiveHandler_t Handler);
+extern int Uart_EpollWait(const int Timeout);
+#endif
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* UART_H */
+/*****************************End of File ************************************/
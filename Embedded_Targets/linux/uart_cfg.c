@@ -0,0 +1,60 @@
+/**
+ * @file uart_cfg.c
+ * @author Mohamed Hassanin
+ * @brief A UART driver configuration file for Linux hosts.
+ * @version 0.1
+ * @date 2021-03-20
+ */
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include "uart_cfg.h"
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/**
+* The following array contains the configuration data for each
+* UART channel. Each row represents a UART channel (a tty device). Each column is
+* representing a member of the UartConfig_t
+* structure. This table is read in by Uart_Init, where each channel is then
+* set up based on this table.
+*/
+static const UartConfig_t UartConfig[] =
+{
+  { UART_0, "/dev/ttyUSB0", 115200, UART_STOP_BIT_1, UART_PARTIY_NO,
+    UART_DATA_BITS_8, UART_FLOW_CONTROL_NONE, CIRCBUFF_DROP_NEW },
+  { UART_1, "/dev/ttyUSB1", 115200, UART_STOP_BIT_1, UART_PARTIY_NO,
+    UART_DATA_BITS_8, UART_FLOW_CONTROL_RTS_CTS, CIRCBUFF_DROP_NEW }
+};
+/**********************************************************************
+* Function Definitions
+**********************************************************************/
+/**********************************************************************
+* Function : Uart_ConfigGet()
+*//**
+* \b Description:
+* This function is used to get the cofiguration handle of the Uart <br>
+* POST-CONDITION: A constant pointer to the first member of the
+* configuration table will be returned. <br>
+* @return A pointer to the configuration table.
+*
+* \b Example Example:
+* @code
+* const Uart_ConfigType *UartConfig = Uart_GetConfig();
+* Uart_Init(UartConfig);
+* @endcode
+* @see Uart_Init
+**********************************************************************/
+extern const UartConfig_t *
+Uart_GetConfig(void)
+{
+  /*
+  * The cast is performed to ensure that the address of the first element
+  * of configuration table is returned as a constant pointer and NOT a
+  * pointer that can be modified.
+  */
+  return (const UartConfig_t *) UartConfig;
+}
+/*****************************End of File ************************************/
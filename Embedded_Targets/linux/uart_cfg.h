@@ -0,0 +1,130 @@
+/**
+ * @file uart_cfg.h
+ * @author Mohamed Hassanin
+ * @brief A UART driver configuration header file for Linux hosts, the
+ * channels are tty devices (serial ports, USB adapters or pseudo-terminals).
+ * @version 0.1
+ * @date 2021-03-20
+ */
+#ifndef UART_CFG_H
+#define UART_CFG_H
+
+/**********************************************************************
+* Includes
+**********************************************************************/
+#include <inttypes.h>
+#include "circ_buffer.h"
+/**********************************************************************
+* Preprocessor constants
+**********************************************************************/
+#define UART_BUFF_SIZE 255 /**< define the number of bytes in a UART buffer,
+a buffer is a segment of at most two contiguous runs for read(2) and
+write(2) */
+
+#ifndef UART_DEV_ERROR_DETECT
+#define UART_DEV_ERROR_DETECT 1 /**< 1 to enable the development error checks
+(invalid parameters), 0 to remove them in release builds */
+#endif
+
+#ifndef UART_EPOLL
+#define UART_EPOLL 1 /**< 1 to add the epoll event loop (Uart_EpollInit,
+Uart_EpollWait) that services the ready channels only, 0 to remove it */
+#endif
+
+#define UART_EPOLL_EVENTS 64 /**< define the largest number of readiness
+events handled by one Uart_EpollWait call */
+
+#define UART_EPOLL_DRAIN_MS 1 /**< define the longest wait of Uart_EpollWait in
+milliseconds while a deferred reconfiguration waits for the tty output queue
+to drain, no event reports it */
+
+#define UART_MODULE_ID 0x01 /**< define the module id to use in
+error handling */
+/**********************************************************************
+* Typedefs
+**********************************************************************/
+
+/**
+ * Defines the possible stop bits
+ */
+typedef enum
+{
+  UART_STOP_BIT_1,
+  UART_STOP_BIT_2,
+  UART_STOP_BIT_MAX,
+}UartStopBit_t;
+
+typedef enum
+{
+  UART_PARTIY_NO,
+  UART_PARTIY_EVEN,
+  UART_PARTIY_ODD,
+} UartParity_t;
+
+/**
+ * Defines the possible flow control options
+ */
+typedef enum
+{
+  UART_FLOW_CONTROL_NONE, /**< no flow control */
+  UART_FLOW_CONTROL_XON_XOFF, /**< in-band software flow control (IXON and
+  IXOFF, handled by the tty driver) */
+  UART_FLOW_CONTROL_RTS_CTS, /**< hardware flow control (CRTSCTS) */
+} UartFlowControl_t;
+
+/**
+ * Defines the possible number of data bits in a frame
+ */
+typedef enum
+{
+  UART_DATA_BITS_5,
+  UART_DATA_BITS_6,
+  UART_DATA_BITS_7,
+  UART_DATA_BITS_8,
+} UartDataBits_t;
+
+/**
+* Defines an enumerated list of all the uart channels of the host. The last
+* element is used to specify the maximum number of enumerated labels.
+*/
+typedef enum
+{
+  /* TODO: Populate this list based on the serial links of the host */
+  UART_0,
+  UART_1,
+#ifdef UART_HOST_CHANNELS
+  UART_MAX = UART_HOST_CHANNELS /**< the host programs open up to 255
+  pseudo-terminal channels, e.g. -DUART_HOST_CHANNELS=128 */
+#else
+  UART_MAX
+#endif
+}Uart_t;
+
+typedef struct
+{
+  Uart_t Uart; /**< the UART channel id */
+  const char* Device; /**< the tty device path, e.g. /dev/ttyUSB0 or the
+  ptsname of a pseudo-terminal */
+  uint32_t Baudrate; /**< the UART baudrate, one of the termios speeds */
+  UartStopBit_t StopBit; /**< the UART number of stop bits */
+  UartParity_t Parity; /**< the UART parity option */
+  UartDataBits_t DataBits; /**< the UART number of data bits */
+  UartFlowControl_t FlowControl; /**< the UART flow control option */
+  CircBuffPolicy_t ReceivePolicy; /**< the receive buffer overflow policy */
+}UartConfig_t;
+
+/******************************************************************************
+ * Function prototypes
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+extern const UartConfig_t* Uart_GetConfig(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* UART_CFG_H */
+/*****************************End of File ************************************/